@@ -0,0 +1,78 @@
+#ifndef ASSET_LOADER_HPP
+#define ASSET_LOADER_HPP
+
+#include <SFML/Graphics.hpp>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Start-up loader. Every queued file is decoded on a small pool of worker
+// threads (PNG -> sf::Image, WAV/OGG -> sf::SoundBuffer, fonts). The main
+// thread then turns decoded images into textures in time-boxed batches from
+// update(), since only it owns the GL context. Results go into
+// ResourceCache, so the systems built afterwards find everything already
+// resident.
+class AssetLoader {
+public:
+    enum class Kind {
+        Texture,    // Decoded off-thread, uploaded by update()
+        Image,      // Kept CPU-side (atlas packing)
+        SoundBuffer,
+        Font
+    };
+
+    AssetLoader() = default;
+    ~AssetLoader();
+
+    AssetLoader(const AssetLoader&) = delete;
+    AssetLoader& operator=(const AssetLoader&) = delete;
+
+    // Queue everything before start()
+    void add(Kind kind, const std::string& path);
+
+    // 0 threads means one per core, leaving one for the main thread
+    void start(unsigned threadCount = 0);
+
+    // Main thread, once per frame: uploads decoded textures until the budget
+    // is spent (always at least one, so progress never stalls)
+    void update(float uploadBudgetMs = 4.f);
+
+    // Fraction of assets fully loaded, for the splash bar
+    float progress() const;
+    bool done() const { return completed == jobs.size(); }
+
+    // Per-asset decode and upload times, slowest decode first
+    void logTimings(std::ostream& out) const;
+
+private:
+    struct Job {
+        Kind kind;
+        std::string path;
+        sf::Image image; // Texture jobs only, until uploaded
+        bool ok = false;
+        bool finished = false; // Main thread only
+        float decodeMs = 0.f;
+        float uploadMs = 0.f;
+        std::atomic<bool> decoded{false};
+
+        Job(Kind kind, const std::string& path) : kind(kind), path(path) {}
+    };
+
+    std::deque<Job> jobs; // Stable addresses for the workers
+    std::vector<std::thread> workers;
+    unsigned threadsUsed = 0;
+    std::atomic<std::size_t> nextJob{0};
+    std::size_t completed = 0;
+    std::size_t finishedPrefix = 0; // Jobs before this are all finished
+    std::chrono::steady_clock::time_point startTime;
+    float totalMs = 0.f;
+
+    void workerLoop();
+    void decode(Job& job);
+};
+
+#endif // ASSET_LOADER_HPP
@@ -0,0 +1,97 @@
+#ifndef AUDIO_MIXER_HPP
+#define AUDIO_MIXER_HPP
+
+#include <SFML/Audio.hpp>
+#include <SFML/System/Vector2.hpp>
+#include "ResourceCache.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+// Fixed pool of sf::Sound voices shared by every sound effect. Game code
+// only calls play(), which records a trigger; update() runs once per frame
+// and turns the triggers into voices:
+//  - triggers of one sound in the same frame, or within mergeWindow of that
+//    sound's last start, merge into one slightly louder voice instead of
+//    stacking copies,
+//  - each category has a voice limit; past it the category's least audible
+//    voice is stolen,
+//  - when the pool is full the least audible voice overall is stolen, but
+//    only for a trigger that is more audible than it.
+// Audibility is priority x distance falloff x the fraction still to play.
+// Voices are built once, by the first addSound(), so play() never allocates
+// and the mixing cost is capped at voiceCount sources.
+class AudioMixer {
+public:
+    enum class Category : std::uint8_t { Explosion, Weapon, Pickup, Powerup, Count };
+    using SoundId = std::uint8_t;
+
+    static constexpr std::size_t voiceCount = 16;
+    static constexpr std::size_t maxSounds = 16;
+    static constexpr SoundId invalidSound = 0xff; // play() ignores it
+    static_assert(maxSounds <= invalidSound, "ids must stay below invalidSound");
+    static constexpr float mergeWindow = 0.06f;     // Seconds
+    static constexpr float falloffDistance = 900.f; // Half volume at this many pixels
+
+    AudioMixer();
+
+    // Returns invalidSound (and logs) once all maxSounds slots are taken
+    SoundId addSound(ResourceHandle<sf::SoundBuffer> buffer, Category category, float priority,
+                     float volume = 100.f);
+    void setCategoryLimit(Category category, std::size_t voices);
+
+    // Distances are measured from here; set it before the frame's play() calls
+    void setListener(sf::Vector2f position) { listener = position; }
+
+    void play(SoundId sound, sf::Vector2f position);
+    void play(SoundId sound) { play(sound, listener); }
+
+    // Starts (or merges) this frame's triggers
+    void update(float dt);
+    void stopAll();
+
+    std::size_t activeVoices() const;
+
+    // Running totals, for tuning the limits
+    std::uint64_t mergedTriggers = 0;
+    std::uint64_t stolenVoices = 0;
+    std::uint64_t droppedTriggers = 0;
+
+private:
+    struct Sound {
+        ResourceHandle<sf::SoundBuffer> buffer;
+        Category category = Category::Explosion;
+        float priority = 1.f;
+        float volume = 100.f;
+        float duration = 0.f;
+    };
+
+    // Triggers of one sound since the last update()
+    struct Pending {
+        int count = 0;
+        float gain = 0.f; // Loudest of them
+    };
+
+    struct Voice {
+        std::optional<sf::Sound> sound;
+        SoundId id = 0;
+        bool active = false;
+        float startTime = 0.f;
+        float gain = 0.f;
+    };
+
+    std::array<Sound, maxSounds> sounds;
+    std::array<Pending, maxSounds> pending;
+    std::array<Voice, voiceCount> voices;
+    std::array<std::size_t, static_cast<std::size_t>(Category::Count)> categoryLimits;
+    std::size_t soundCount = 0;
+    sf::Vector2f listener;
+    float now = 0.f;
+
+    float audibility(const Voice& voice) const;
+    Voice* allocate(Category category, float score);
+    void start(Voice& voice, SoundId id, float gain);
+};
+
+#endif
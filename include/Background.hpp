@@ -3,39 +3,99 @@
 
 #include <SFML/Graphics.hpp>
 #include <vector>
-#include <map>
 #include <utility>
 #include <memory>
 #include <random>
 #include <string>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "TextureAtlas.hpp"
+#include "SpscQueue.hpp"
+#include "CoordMap.hpp"
 
+// Chunks are generated on a worker thread. update() asks for the chunks
+// around the camera and ahead of it, and picks up whatever the worker has
+// finished. Only a chunk that is already on screen and still missing gets
+// built on the calling thread.
 class Background {
 public:
-    Background(const std::string& resourcePath);
-    void update(const sf::Vector2f& cameraPos, const sf::Vector2f& viewSize);
+    // Ticks of travel along the camera velocity that get prefetched
+    static constexpr float prefetchTicks = 120.f;
+
+    // The seed picks the star and planet layout; pass a recorded one to
+    // reproduce a session's chunk generation
+    Background(const std::string& resourcePath, bool asyncGeneration = true,
+               unsigned int seed = std::random_device{}());
+    ~Background();
+
+    // cameraVelocity is in pixels per tick, like the player's velocity
+    void update(const sf::Vector2f& cameraPos, const sf::Vector2f& viewSize, sf::Vector2f cameraVelocity = {0.f, 0.f});
     void draw(sf::RenderWindow& window, sf::Vector2f playerVelocity = {0.f, 0.f});
 
+    // Chunks built on the calling thread because the worker hadn't got there
+    std::size_t syncChunkCount = 0;
+
 private:
+    // Geometry is baked once when the chunk is generated. Chunks that fall
+    // out of range go back to a free list and are refilled in place.
     struct Chunk {
         sf::Vector2i gridPos;
-        std::vector<sf::Sprite> sprites;
+        int layerIndex = 0;
+        std::vector<sf::Vertex> vertices; // Triangles, world space
     };
 
+    // Every chunk of a layer is concatenated into one buffer, rebuilt only
+    // when chunks are added or dropped, so a layer is a single draw call
     struct Layer {
+        explicit Layer(float parallaxFactor) : parallaxFactor(parallaxFactor) {}
+
         float parallaxFactor;
-        std::map<std::pair<int, int>, std::unique_ptr<Chunk>> chunks;
+        // Null entries are queued on the worker but not back yet
+        CoordMap<std::unique_ptr<Chunk>> chunks;
+        std::vector<sf::Vertex> vertices;
+        sf::VertexBuffer buffer{sf::PrimitiveType::Triangles, sf::VertexBuffer::Usage::Dynamic};
+        bool dirty = true;
     };
 
     int chunkSize = 1024;
     std::vector<Layer> layers;
-    std::vector<sf::Texture> starTextures;
-    std::vector<sf::Texture> planetTextures;
-    sf::Texture whiteTexture;
+    TextureAtlas atlas; // Stars and planets
+    std::vector<int> starRegions;
+    std::vector<int> planetRegions;
+    sf::Shader dustShader;
+    bool dustShaderReady = false;
     unsigned int seed;
 
+    // Worker thread: requests go in under a mutex, finished chunks come
+    // back through a lock-free queue
+    struct ChunkRequest {
+        int cx, cy, layerIndex;
+        std::unique_ptr<Chunk> storage; // Recycled chunk to fill
+    };
+    bool asyncGeneration;
+    std::thread worker;
+    std::mutex requestMutex;
+    std::condition_variable requestReady;
+    std::deque<ChunkRequest> requests;
+    bool stopping = false;
+    SpscQueue<std::unique_ptr<Chunk>, 256> finished;
+    std::vector<ChunkRequest> newRequests; // Scratch for one update()
+    std::vector<std::unique_ptr<Chunk>> freeChunks;
+    std::vector<sf::Vector2i> farChunks; // Scratch for removeFarChunks()
+
     void loadTextures(const std::string& resourcePath);
-    void generateChunk(int cx, int cy, int layerIndex);
-    void removeFarChunks(int cx, int cy, int radius, int layerIndex);
+    // Pure function of (cx, cy, layer, seed); safe to call from any thread
+    std::unique_ptr<Chunk> generateChunk(int cx, int cy, int layerIndex, std::unique_ptr<Chunk> chunk) const;
+    std::unique_ptr<Chunk> takeChunk();
+    void recycleChunk(std::unique_ptr<Chunk> chunk);
+    void insertChunk(std::unique_ptr<Chunk> chunk);
+    void collectFinishedChunks();
+    void requestChunks(int layerIndex, sf::Vector2i center, int radius);
+    void removeFarChunks(sf::Vector2i center, sf::Vector2i ahead, int radius, int layerIndex);
+    void rebuildLayer(Layer& layer);
+    void workerLoop();
 };
 
 #endif // BACKGROUND_HPP
@@ -0,0 +1,121 @@
+#ifndef COORD_MAP_HPP
+#define COORD_MAP_HPP
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Flat open-addressed hash map keyed by an (x, y) grid coordinate packed
+// into 64 bits. Linear probing keeps lookups in one or two cache lines and
+// erase shifts later entries back, so there are no tombstones to sweep.
+template <typename T>
+class CoordMap {
+public:
+    CoordMap() : CoordMap(64) {}
+    explicit CoordMap(std::size_t initialCapacity) {
+        std::size_t capacity = 16;
+        while (capacity < initialCapacity) capacity *= 2;
+        slots.resize(capacity);
+    }
+
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    T* find(int x, int y) {
+        std::uint64_t key = pack(x, y);
+        for (std::size_t i = home(key);; i = next(i)) {
+            if (!slots[i].used) return nullptr;
+            if (slots[i].key == key) return &slots[i].value;
+        }
+    }
+
+    bool contains(int x, int y) { return find(x, y) != nullptr; }
+
+    // Returns the existing value, or a default-constructed one
+    T& insert(int x, int y) {
+        if ((count + 1) * 2 > slots.size()) grow();
+        std::uint64_t key = pack(x, y);
+        std::size_t i = home(key);
+        for (; slots[i].used; i = next(i)) {
+            if (slots[i].key == key) return slots[i].value;
+        }
+        slots[i].used = true;
+        slots[i].key = key;
+        count++;
+        return slots[i].value;
+    }
+
+    void erase(int x, int y) {
+        std::uint64_t key = pack(x, y);
+        std::size_t i = home(key);
+        while (true) {
+            if (!slots[i].used) return;
+            if (slots[i].key == key) break;
+            i = next(i);
+        }
+
+        // Backward-shift: pull later entries of the probe run into the hole
+        std::size_t hole = i;
+        for (std::size_t j = next(i); slots[j].used; j = next(j)) {
+            std::size_t want = home(slots[j].key);
+            // Move j into the hole unless its home lies cyclically in (hole, j]
+            bool stays = hole <= j ? (hole < want && want <= j) : (hole < want || want <= j);
+            if (!stays) {
+                slots[hole].key = slots[j].key;
+                slots[hole].value = std::move(slots[j].value);
+                hole = j;
+            }
+        }
+        slots[hole].used = false;
+        slots[hole].value = T();
+        count--;
+    }
+
+    // fn(x, y, value) for every entry, in slot order
+    template <typename Fn>
+    void forEach(Fn&& fn) {
+        for (Slot& slot : slots) {
+            if (slot.used) fn(unpackX(slot.key), unpackY(slot.key), slot.value);
+        }
+    }
+
+private:
+    struct Slot {
+        std::uint64_t key = 0;
+        T value{};
+        bool used = false;
+    };
+
+    std::vector<Slot> slots;
+    std::size_t count = 0;
+
+    static std::uint64_t pack(int x, int y) {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) | static_cast<std::uint32_t>(y);
+    }
+    static int unpackX(std::uint64_t key) { return static_cast<int>(static_cast<std::uint32_t>(key >> 32)); }
+    static int unpackY(std::uint64_t key) { return static_cast<int>(static_cast<std::uint32_t>(key)); }
+
+    std::size_t home(std::uint64_t key) const {
+        // Fibonacci hashing spreads neighbouring coordinates apart
+        return static_cast<std::size_t>((key * 0x9E3779B97F4A7C15ull) >> 32) & (slots.size() - 1);
+    }
+    std::size_t next(std::size_t i) const { return (i + 1) & (slots.size() - 1); }
+
+    void grow() {
+        std::vector<Slot> old = std::move(slots);
+        slots.clear();
+        slots.resize(old.size() * 2);
+        count = 0;
+        for (Slot& slot : old) {
+            if (!slot.used) continue;
+            std::size_t i = home(slot.key);
+            while (slots[i].used) i = next(i);
+            slots[i].used = true;
+            slots[i].key = slot.key;
+            slots[i].value = std::move(slot.value);
+            count++;
+        }
+    }
+};
+
+#endif // COORD_MAP_HPP
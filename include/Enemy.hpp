@@ -1,76 +1,105 @@
 #ifndef ENEMY_HPP
 #define ENEMY_HPP
-#include <SFML/Graphics.hpp>
-#include <cmath>
-#include "window.hpp"
+#include <SFML/System/Vector2.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <cstdint>
+#include "Random.hpp"
+#include <vector>
 #include "effects.hpp"
+#include "SpatialHash.hpp"
 
-class Enemy {
+// Every enemy lives in one structure-of-arrays pool. Hot per-tick passes
+// (seek, dead/recycle tests) run as SIMD kernels over the packed float
+// arrays; sprites are only built by the renderer.
+class EnemyPool {
 public:
-    float width = 72.f;
-    float height = 72.f;
-    float speed = 2.1f;
-    float baseSpeed = 2.1f;
-    float explosionDamage = 30.f; 
-    sf::Color color = sf::Color::White;
-    sf::Sprite body;
-    Trail trail; // Enemy Trail
-    static sf::Texture textureInitial;
-    static sf::Texture textureExplosion;
-    static bool texturesLoaded;
-    int maxHp = 100;
-    int HP = 100;
-    
-    // Default constructor must initialize body with a texture
-    Enemy() : body(textureInitial) {}
-    
-    Enemy(const Window &Game);
-    static void loadTextures();
-    
-    void update(float dt) {
-        trail.update(body.getPosition(), dt);
-    }
+    // Tuning shared by every enemy
+    static constexpr float width = 72.f;
+    static constexpr float height = 72.f;
+    static constexpr float baseSpeed = 126.f;     // Pixels per second
+    static constexpr float explosionDamage = 30.f;
+    static constexpr float maxHp = 100.f;
+    static constexpr float warningRadius = 209.f; // Switches to the pre-explosion sprite
+    static constexpr float explodeRadius = 100.f;
+    static constexpr float spawnMargin = 50.f;
 
-    void moveTowards(const sf::Vector2f& playerPos) {
-        sf::Vector2f pos = body.getPosition();
-        sf::Vector2f dir = playerPos - pos;
-        float len = std::sqrt(dir.x*dir.x + dir.y*dir.y);
-        if (len > 0.0001f) {
-            dir.x /= len;
-            dir.y /= len;
-            body.move(dir * speed);
-        }
-    }
+    // Per-enemy result bits. classify() writes Dead/Recycle for the whole
+    // pool; markNearPlayer() adds the distance bits from a grid query.
+    enum Flag : std::uint8_t {
+        NearPlayer = 1 << 0,
+        Explode    = 1 << 1,
+        Dead       = 1 << 2,
+        Recycle    = 1 << 3  // Off-screen and left behind by the player
+    };
 
-    void takeDamage(int dmg){
-        HP -= dmg;
-        if(HP < 0) HP = 0;
-    }
+    // Arrays are padded to a multiple of laneWidth so kernels never need a
+    // scalar tail; padding lanes hold zeros and are ignored.
+    static constexpr std::size_t laneWidth = 8;
+    // Enemies per job for the per-tick passes; keep a multiple of laneWidth
+    // so no job starts mid-vector
+    static constexpr std::size_t jobGrain = 1024;
 
-    bool isDead() const { return HP <= 0; }
+    std::vector<float> posX, posY;
+    std::vector<float> prevX, prevY; // Positions at the previous simulation tick
+    std::vector<float> speed;
+    std::vector<float> hp;
+    std::vector<std::uint8_t> flags;
+    // Unique per spawn, so an enemy respawned into a slot reads as a new one
+    std::vector<std::uint32_t> serial;
+    TrailPool trails;
+    Rng rng; // Spawn positions; World::seed() reseeds it
 
-    void applyKnockback(const sf::Vector2f &dir, float force){
-        body.move(dir * force);
-    }
-    void updateVisualState(sf::Vector2f playerPos) {
-        sf::Vector2f pos = body.getPosition();
-        //calculate the distance between enemy and player
-        if(std::sqrt((playerPos.x - pos.x)*(playerPos.x - pos.x) + (playerPos.y - pos.y)*(playerPos.y - pos.y)) < 209.f) {
-            body.setTexture(textureExplosion); // Change texture when close to player
-        } else {
-            body.setTexture(textureInitial); // Reset to original texture
-        }
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    void reserve(std::size_t n);
+    void clear();
+
+    // Adds an enemy on the edge of the view and returns its slot
+    std::size_t spawn(const sf::FloatRect &viewBounds, float difficulty);
+    void respawn(std::size_t i, const sf::FloatRect &viewBounds, float difficulty);
+
+    sf::Vector2f position(std::size_t i) const { return {posX[i], posY[i]}; }
+    sf::Vector2f prevPosition(std::size_t i) const { return {prevX[i], prevY[i]}; }
+
+    // Axis-aligned hitbox centred on the enemy
+    sf::FloatRect getBounds(std::size_t i) const {
+        return {{posX[i] - width / 2.f, posY[i] - height / 2.f}, {width, height}};
     }
-    bool shouldExplode(const sf::Vector2f& playerPos) const {
-        sf::Vector2f pos = body.getPosition();
-        float distanceSquared = (playerPos.x - pos.x)*(playerPos.x - pos.x) + (playerPos.y - pos.y)*(playerPos.y - pos.y);
-        return distanceSquared < (100.f * 100.f); // Explode if within 30 units
+
+    void takeDamage(std::size_t i, float dmg) {
+        hp[i] -= dmg;
+        if (hp[i] < 0.f) hp[i] = 0.f;
     }
-    void applyShockwave(const sf::Vector2f& playerPos, float shockwaveForce,float time){
 
+    void applyKnockback(std::size_t i, const sf::Vector2f &dir, float force) {
+        posX[i] += dir.x * force;
+        posY[i] += dir.y * force;
     }
-    void respawn(const sf::View &view, float margin);
-    void applyDifficulty(float difficulty);
+
+    // Copies current positions into prevX/prevY
+    void snapshot();
+    void updateTrails(float dt);
+
+    // Fills flags[] for every enemy against the player and camera rectangle
+    void classify(sf::Vector2f playerPos, sf::Vector2f playerVel, const sf::FloatRect &viewBounds);
+
+    // Inserts every enemy into the grid and builds it
+    void buildGrid(SpatialHash &grid) const;
+
+    // Sets NearPlayer/Explode for enemies the grid finds around the player
+    void markNearPlayer(const SpatialHash &grid, sf::Vector2f playerPos);
+
+    // Moves every enemy straight at the target
+    void seek(sf::Vector2f target, float dt);
+
+private:
+    std::size_t count = 0;
+    std::uint32_t nextSerial = 0;
+
+    void resizeArrays(std::size_t n);
+    void classifyRange(std::size_t begin, std::size_t end, sf::Vector2f playerPos, sf::Vector2f playerVel,
+                       const sf::FloatRect &viewBounds);
+    void seekRange(std::size_t begin, std::size_t end, sf::Vector2f target, float dt);
 };
 
-#endif
\ No newline at end of file
+#endif
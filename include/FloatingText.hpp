@@ -0,0 +1,59 @@
+#ifndef FLOATING_TEXT_HPP
+#define FLOATING_TEXT_HPP
+
+#include <SFML/Graphics.hpp>
+#include "GlyphAtlas.hpp"
+#include <cstdint>
+#include "Random.hpp"
+#include <string_view>
+#include <vector>
+
+// Combat popups ("Repaired! -500", damage numbers) that drift up and fade.
+// A fixed pool of short strings: spawning copies the characters in, fading
+// is a per-vertex alpha, and every live popup goes out in one draw from a
+// streaming vertex buffer against the glyph atlas. Nothing is allocated
+// after construction; when the pool is full the oldest popup is replaced.
+class FloatingTextPool {
+public:
+    static constexpr std::size_t capacity = 512;
+    static constexpr std::size_t maxLength = 16; // Longer strings are cut
+    static constexpr unsigned characterSize = 20;
+
+    explicit FloatingTextPool(const sf::Font& font);
+
+    // Drift directions; reseed for repeatable runs
+    void seed(std::uint32_t masterSeed) { rng.seed(masterSeed, RngStream::FloatingText); }
+
+    void spawn(std::string_view str, sf::Vector2f position, sf::Color color, float duration = 1.f,
+               float scale = 1.f);
+    void spawnNumber(int value, sf::Vector2f position, sf::Color color, float duration = 1.f, float scale = 1.f);
+
+    void update(float dt);
+    void draw(sf::RenderTarget& target);
+
+    void clear() { liveCount = 0; }
+    std::size_t size() const { return liveCount; }
+
+private:
+    struct Popup {
+        sf::Vector2f position; // Centre of the text
+        sf::Vector2f velocity;
+        float lifetime = 0.f;
+        float maxLifetime = 1.f;
+        float scale = 1.f;
+        float width = 0.f; // Unscaled advance width, for centring
+        sf::Color color;
+        std::uint8_t length = 0;
+        char text[maxLength];
+    };
+
+    GlyphAtlas atlas;
+    std::vector<Popup> popups;
+    std::size_t liveCount = 0;
+    Rng rng;
+
+    std::vector<sf::Vertex> vertices;
+    sf::VertexBuffer buffer;
+};
+
+#endif // FLOATING_TEXT_HPP
@@ -0,0 +1,105 @@
+#ifndef GAME_EVENTS_HPP
+#define GAME_EVENTS_HPP
+
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+// Gameplay events. The simulation only publishes them; sound, particles,
+// shake and popups happen in subscribers, once per rendered frame.
+struct EnemyKilled {
+    sf::Vector2f position;
+};
+
+struct PlayerHit {
+    sf::Vector2f position;
+    float damage;
+    bool fatal; // Ended the game
+};
+
+struct CoinCollected {
+    sf::Vector2f position;
+    int value;
+};
+
+struct OrbCollected {
+    sf::Vector2f position;
+};
+
+// Every tick the beam fires; started marks the first tick of a burst
+struct LaserFired {
+    bool started;
+};
+
+struct LaserHit {
+    sf::Vector2f position;
+    float damage;
+    std::uint32_t enemy; // EnemyPool::serial of the enemy hit; slots get reused
+};
+
+struct Repaired {
+    sf::Vector2f position;
+    int cost;
+};
+
+// Typed event queues, one per event type. publish() appends to the queue;
+// dispatch() hands each subscriber the whole queue of its type as one span,
+// then clears everything. Ten kills in a frame reach a subscriber as one
+// call with ten events, so it can coalesce them (one voice, one burst)
+// instead of reacting ten times.
+//
+// Types dispatch in the order they are listed, subscribers in the order
+// they subscribed. Queues keep their capacity, so a warm bus never
+// allocates. Handlers must not publish.
+template <typename... Events>
+class EventBus {
+public:
+    template <typename Event>
+    using Handler = std::function<void(std::span<const Event>)>;
+
+    template <typename Event>
+    void publish(const Event& event) { channel<Event>().queue.push_back(event); }
+
+    template <typename Event>
+    void subscribe(Handler<Event> handler) { channel<Event>().handlers.push_back(std::move(handler)); }
+
+    // Events of one type published since the last dispatch
+    template <typename Event>
+    std::span<const Event> pending() const { return std::get<Channel<Event>>(channels).queue; }
+
+    void dispatch() {
+        std::apply([](auto&... channel) { (channel.dispatch(), ...); }, channels);
+    }
+
+    // Drops queued events; subscribers stay
+    void clear() {
+        std::apply([](auto&... channel) { (channel.queue.clear(), ...); }, channels);
+    }
+
+private:
+    template <typename Event>
+    struct Channel {
+        std::vector<Event> queue;
+        std::vector<Handler<Event>> handlers;
+
+        void dispatch() {
+            if (queue.empty()) return;
+            for (auto& handler : handlers) handler(std::span<const Event>(queue));
+            queue.clear();
+        }
+    };
+
+    std::tuple<Channel<Events>...> channels;
+
+    template <typename Event>
+    Channel<Event>& channel() { return std::get<Channel<Event>>(channels); }
+};
+
+using GameEvents = EventBus<EnemyKilled, PlayerHit, CoinCollected, OrbCollected, LaserFired, LaserHit, Repaired>;
+
+#endif // GAME_EVENTS_HPP
@@ -0,0 +1,63 @@
+#ifndef GLYPH_ATLAS_HPP
+#define GLYPH_ATLAS_HPP
+
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <string_view>
+
+// Printable ASCII of one font at one size, baked up front (fill and
+// outline glyphs plus a kerning table) into the font's page texture.
+// Strings laid out from here are plain textured quads, so any number of
+// them can share one draw call, and changing a colour is a vertex write
+// rather than the geometry rebuild sf::Text does.
+class GlyphAtlas {
+public:
+    static constexpr char firstChar = 32; // Space
+    static constexpr char lastChar = 126; // '~'
+    static constexpr std::size_t glyphCount = lastChar - firstChar + 1;
+
+    GlyphAtlas(const sf::Font& font, unsigned characterSize, float outlineThickness = 0.f);
+
+    const sf::Texture& texture() const { return font.getTexture(characterSize); }
+    unsigned size() const { return characterSize; }
+
+    // Ink rectangle of c's fill glyph, relative to the pen on the baseline
+    sf::FloatRect glyphBounds(char c) const {
+        const sf::FloatRect& b = fill[index(c)].bounds;
+        return {{b.position.x + 1.f, b.position.y + 1.f}, {b.size.x - 2.f, b.size.y - 2.f}};
+    }
+
+    // Advance width of str, kerning included
+    float measure(std::string_view str) const;
+
+    // Writes 6 vertices per visible glyph of str, the outline quads (if the
+    // atlas has an outline) before the fill quads, like sf::Text. origin is
+    // the top-left of the line. Returns the vertex count; out needs room for
+    // maxVertices(str.size()).
+    std::size_t build(sf::Vertex* out, std::string_view str, sf::Vector2f origin, float scale,
+                      sf::Color fillColor, sf::Color outlineColor) const;
+
+    static constexpr std::size_t maxVertices(std::size_t length) { return length * 12; }
+
+private:
+    struct Glyph {
+        sf::FloatRect bounds;
+        sf::FloatRect texRect;
+        float advance = 0.f;
+    };
+
+    const sf::Font& font;
+    unsigned characterSize;
+    bool hasOutline;
+    std::array<Glyph, glyphCount> fill;
+    std::array<Glyph, glyphCount> outline;
+    std::array<float, glyphCount * glyphCount> kerning;
+
+    static std::size_t index(char c) {
+        return (c < firstChar || c > lastChar) ? '?' - firstChar : static_cast<std::size_t>(c - firstChar);
+    }
+    std::size_t addQuads(sf::Vertex* out, std::string_view str, sf::Vector2f origin, float scale,
+                         const std::array<Glyph, glyphCount>& glyphs, sf::Color color) const;
+};
+
+#endif // GLYPH_ATLAS_HPP
@@ -3,10 +3,18 @@
 
 #include <SFML/Graphics.hpp>
 #include "player.hpp"
+#include "ResourceCache.hpp"
+#include "GlyphAtlas.hpp"
 #include <vector>
-#include <string>
 #include <optional>
 
+// Retained-mode HUD. Bars, charge pips and the coin counter are baked into
+// one triangle list when the HUD is built. update() compares the player's
+// stats with what is on screen and patches only the vertices that changed,
+// and the list is re-uploaded only on frames where something did. The
+// untextured parts sample the white square SFML keeps in the corner of every
+// font page, so they share a draw with the counter digits; the animated coin
+// icon is the second draw.
 class HUD {
 public:
     HUD(const sf::Font& font, const sf::Vector2f& windowSize);
@@ -14,35 +22,56 @@ public:
     void update(const Player& player, int coins, float dt);
     void draw(sf::RenderWindow& window);
 
+    // Adds a framed bar; returns the id for setGauge()
+    std::size_t addGauge(const sf::Vector2f& position, const sf::Vector2f& size, const sf::Color& color);
+    // Patches the bar only if its pixel width or colour changed
+    void setGauge(std::size_t id, float fraction, const sf::Color& color);
+
 private:
-    const sf::Font& font;
-    sf::Vector2f windowSize;
+    static constexpr std::size_t maxDigits = 11; // Sign plus the digits of any int
+    static constexpr unsigned counterSize = 32;
+    static constexpr unsigned circlePoints = 30; // Same as sf::CircleShape
+
+    struct Gauge {
+        std::size_t first; // Foreground quad in vertices
+        sf::Vector2f position;
+        sf::Vector2f size;
+        float width;
+        sf::Color color;
+    };
 
-    // Helper to create a bar
-    struct Bar {
-        sf::RectangleShape background;
-        sf::RectangleShape foreground;
-        sf::RectangleShape border;
+    struct Pip {
+        std::size_t first; // Fill triangles in vertices
+        bool lit;
     };
 
-    Bar healthBar;
-    Bar energyBar;
-    Bar dashBar;
+    GlyphAtlas digits;
+    sf::Vector2f windowSize;
+
+    std::vector<sf::Vertex> vertices;
+    sf::VertexBuffer buffer;
+    bool dirty = true;
+
+    std::vector<Gauge> gauges;
+    std::size_t healthGauge, energyGauge, dashGauge;
+    std::vector<Pip> pips; // Shockwave charges
 
-    // Shockwave charges
-    std::vector<sf::CircleShape> shockwaveCircles;
+    // Coin counter, right-aligned against the icon
+    std::size_t counterFirst;
+    sf::Vector2f counterAnchor; // Right edge, vertical centre
+    int shownCoins = -1;
 
-    // Coins
-    // Coins
-    sf::Text coinText;
     std::optional<sf::Sprite> coinSprite;
-    std::vector<sf::Texture> coinTextures;
+    std::vector<ResourceHandle<sf::Texture>> coinTextures;
     int currentCoinFrame = 0;
     float coinAnimTimer = 0.f;
 
-    // Initialization helpers
-    void initBar(Bar& bar, const sf::Vector2f& position, const sf::Vector2f& size, const sf::Color& fillColor);
-    void updateBar(Bar& bar, float percentage, const sf::Color& color);
+    std::size_t addRect(const sf::FloatRect& rect, const sf::Color& color);
+    void setRect(std::size_t first, const sf::FloatRect& rect, const sf::Color& color);
+    std::size_t addCircle(const sf::Vector2f& center, float radius, const sf::Color& color);
+    void addRing(const sf::Vector2f& center, float radius, float thickness, const sf::Color& color);
+    void setPip(std::size_t i, bool lit);
+    void setCoins(int coins);
 };
 
 #endif // HUD_HPP
@@ -0,0 +1,77 @@
+#ifndef INPUT_RECORDING_HPP
+#define INPUT_RECORDING_HPP
+
+#include "World.hpp"
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+// Binary record of one game session, enough to re-run it tick for tick:
+//
+//   header   RecordingHeader below (written field by field, little-endian)
+//   ticks    5 bytes each: button bits, then the aim as int16 x/y offsets
+//            from the player
+//   hashes   after every hashInterval-th tick, World::stateHash() as uint64
+//
+// The aim is rounded to whole pixels before the World sees it, both when
+// recording and when replaying, so both runs feed the World the same floats.
+// A recording stops when the player dies; replay ends at the same tick.
+// Runs only match on builds with the same floating-point code paths (the
+// enemy SIMD kernels differ between SSE2 and AVX builds); the hashes show
+// where that happens.
+
+struct RecordingHeader {
+    std::uint32_t seed = 0;           // World::seed()
+    std::uint32_t backgroundSeed = 0; // Background chunk layout
+    std::uint32_t hashInterval = 60;  // Ticks between state hashes
+    sf::Vector2f viewSize;            // World camera rectangle
+    sf::Vector2f spawn;               // World::reset() position
+    std::uint32_t baseEnemyCount = 0;
+    std::uint32_t maxEnemyCount = 0;
+};
+
+class InputRecorder {
+public:
+    bool open(const std::string& path, const RecordingHeader& header);
+    void close();
+    bool isOpen() const { return file.is_open(); }
+
+    // Quantizes live input, writes it and returns what the World should get
+    PlayerInput record(const PlayerInput& input, sf::Vector2f playerPos);
+
+    // Call after each World::step(); writes the hash when one is due
+    void afterStep(const World& world);
+
+    std::uint64_t ticks() const { return tickCount; }
+
+private:
+    std::ofstream file;
+    std::uint32_t hashInterval = 60;
+    std::uint64_t tickCount = 0;
+};
+
+class InputReplay {
+public:
+    bool open(const std::string& path);
+    const RecordingHeader& header() const { return head; }
+
+    // Fills in the next tick's input; false once the recording runs out
+    bool next(PlayerInput& input, sf::Vector2f playerPos);
+
+    // Call after each World::step(); compares the hash when one is due.
+    // The first mismatch is logged and kept in divergedAt.
+    void afterStep(const World& world);
+
+    bool diverged() const { return divergedAt != 0; }
+    std::uint64_t divergedAt = 0; // Tick of the first hash mismatch
+    std::uint64_t hashesChecked = 0;
+    std::uint64_t ticks() const { return tickCount; }
+
+private:
+    std::ifstream file;
+    std::string path;
+    RecordingHeader head;
+    std::uint64_t tickCount = 0;
+};
+
+#endif // INPUT_RECORDING_HPP
@@ -0,0 +1,133 @@
+#ifndef JOB_SYSTEM_HPP
+#define JOB_SYSTEM_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Work-stealing pool for data-parallel passes over entity arrays.
+//
+// parallelFor() cuts [0, count) into chunks of `grain` items and spreads
+// them over one deque per thread (the caller has one too). Each thread pops
+// from the back of its own deque and, when that is empty, steals from the
+// front of another. The caller works until every chunk is done, so a call
+// returns only when the whole range has been processed.
+//
+// Chunk boundaries depend only on count and grain, never on the thread
+// count, so per-chunk results (see CommandBuffers) merge in the same order
+// on any machine, and a run matches the single-threaded one bit for bit.
+// Ranges of a single chunk run inline with no scheduling at all.
+//
+// parallelFor() is meant for one thread at a time (the simulation) and must
+// not be nested. Job bodies must not touch shared state other than their
+// own range and their own chunk's buffer.
+class JobSystem {
+public:
+    static JobSystem& instance();
+
+    // Worker threads besides the caller; 0 runs everything inline. The
+    // default is LSS_THREADS if set, otherwise one per core minus the caller.
+    void setWorkerCount(unsigned count);
+    unsigned workerCount() const { return static_cast<unsigned>(workers.size()); }
+
+    static std::size_t chunkCount(std::size_t count, std::size_t grain) {
+        return grain == 0 ? 0 : (count + grain - 1) / grain;
+    }
+
+    // fn(begin, end, chunk) for every chunk of the range
+    template <typename Fn>
+    void parallelFor(std::size_t count, std::size_t grain, Fn&& fn) {
+        std::size_t chunks = chunkCount(count, grain);
+        if (chunks <= 1 || workers.empty()) {
+            for (std::size_t c = 0; c < chunks; ++c) fn(c * grain, std::min(count, (c + 1) * grain), c);
+            return;
+        }
+        Task task;
+        task.count = count;
+        task.grain = grain;
+        task.context = &fn;
+        task.invoke = [](void* context, std::size_t begin, std::size_t end, std::size_t chunk) {
+            (*static_cast<std::remove_reference_t<Fn>*>(context))(begin, end, chunk);
+        };
+        run(task, chunks);
+    }
+
+    ~JobSystem();
+
+private:
+    struct Task {
+        void (*invoke)(void*, std::size_t, std::size_t, std::size_t) = nullptr;
+        void* context = nullptr;
+        std::size_t count = 0;
+        std::size_t grain = 0;
+        std::atomic<std::size_t> remaining{0};
+    };
+
+    struct Job {
+        Task* task;
+        std::size_t chunk;
+    };
+
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    JobSystem();
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    std::vector<std::thread> workers;
+    std::vector<std::unique_ptr<Queue>> queues; // One per worker, then the caller's
+
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    std::uint64_t generation = 0; // Bumped under sleepMutex whenever work is queued
+    bool stopping = false;
+
+    void run(Task& task, std::size_t chunks);
+    void workerLoop(std::size_t self);
+    bool popOrSteal(std::size_t self, Job& job);
+    static void execute(const Job& job);
+    void stopWorkers();
+};
+
+// One buffer of commands per chunk of a parallelFor. Bodies push side
+// effects they can't apply in parallel (damage, spawns, sounds) into their
+// chunk's buffer; merge() then replays them in chunk order, which is the
+// order the single-threaded loop would have produced them in.
+template <typename Command>
+class CommandBuffers {
+public:
+    void reset(std::size_t chunks) {
+        if (buffers.size() < chunks) buffers.resize(chunks);
+        for (auto& buffer : buffers) buffer.clear();
+        used = chunks;
+    }
+
+    std::vector<Command>& operator[](std::size_t chunk) { return buffers[chunk]; }
+
+    // fn(command) in order; stops early once fn returns false
+    template <typename Fn>
+    void merge(Fn&& fn) {
+        for (std::size_t c = 0; c < used; ++c) {
+            for (const Command& command : buffers[c]) {
+                if (!fn(command)) return;
+            }
+        }
+    }
+
+private:
+    std::vector<std::vector<Command>> buffers; // Kept between frames, so no allocation once warm
+    std::size_t used = 0;
+};
+
+#endif // JOB_SYSTEM_HPP
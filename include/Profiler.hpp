@@ -0,0 +1,128 @@
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Frame-time profiler. PROFILE_SCOPE(Zone) times the rest of the enclosing
+// block; the time is added to that zone's total for the current frame and
+// the span is logged for the Chrome trace. endFrame() closes the frame and
+// pushes one FrameSample into a ring the overlay and CSV dump read from.
+//
+// Scopes may be hit from any thread (the background worker records chunk
+// generation): zone totals are atomics and event slots are claimed with a
+// fetch_add, overwriting the oldest. The slots themselves are plain writes,
+// so only call writeChromeTrace() once every other recording thread has
+// stopped. Frames are only written by endFrame() on the main thread.
+// Zones nest, so totals are inclusive (DrawEntities contains DrawParticles).
+//
+// Define LSS_NO_PROFILE to compile every scope out.
+
+enum class ProfileZone : std::uint8_t {
+    Input,
+    Simulation,
+    Spawn,
+    Particles,
+    Laser,
+    Pickups,
+    Enemies,
+    ChunkGeneration,
+    BackgroundUpdate,
+    HudUpdate,
+    DrawBackground,
+    DrawEntities,
+    DrawParticles,
+    DrawText,
+    DrawHud,
+    Present,
+    Count
+};
+
+constexpr std::size_t profileZoneCount = static_cast<std::size_t>(ProfileZone::Count);
+
+const char* profileZoneName(ProfileZone zone);
+
+class Profiler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr std::size_t frameCapacity = 4096; // ~68 s at 60 fps
+    static constexpr std::size_t eventCapacity = 1 << 16;
+
+    struct FrameSample {
+        std::uint64_t frame = 0;
+        float frameMs = 0.f; // Raw, before the game loop's dt clamp
+        std::array<float, profileZoneCount> zoneMs{};
+    };
+
+    struct Stats {
+        float min = 0.f, avg = 0.f, p99 = 0.f;
+    };
+
+    static Profiler& instance();
+
+    // Set to record zones at all; scopes are two clock reads when on
+    std::atomic<bool> enabled{true};
+
+    void record(ProfileZone zone, Clock::time_point start, Clock::time_point end);
+
+    // Closes the current frame. Call once per frame from the main thread.
+    void endFrame();
+
+    // Rolling stats over the newest `frames` samples (zone == Count means whole frame)
+    Stats stats(ProfileZone zone, std::size_t frames = 240) const;
+    std::size_t frameCount() const { return framesWritten.load(std::memory_order_acquire); }
+
+    bool writeCsv(const std::string& path) const;
+    bool writeChromeTrace(const std::string& path) const;
+
+private:
+    Profiler();
+
+    struct Event {
+        std::uint64_t startNs = 0;
+        std::uint32_t durationNs = 0;
+        std::uint8_t zone = 0;
+        std::uint8_t thread = 0;
+    };
+
+    Clock::time_point origin;
+    Clock::time_point frameStart;
+    std::array<std::atomic<std::uint64_t>, profileZoneCount> zoneNs;
+
+    std::vector<FrameSample> frames;
+    std::atomic<std::size_t> framesWritten{0};
+
+    std::vector<Event> events;
+    std::atomic<std::size_t> eventsWritten{0};
+
+    // Copies the newest `count` samples out in order
+    void copyFrames(std::vector<FrameSample>& out, std::size_t count) const;
+};
+
+class ProfileScope {
+public:
+    explicit ProfileScope(ProfileZone zone) : zone(zone), start(Profiler::Clock::now()) {}
+    ~ProfileScope() { Profiler::instance().record(zone, start, Profiler::Clock::now()); }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    ProfileZone zone;
+    Profiler::Clock::time_point start;
+};
+
+#ifdef LSS_NO_PROFILE
+#define PROFILE_SCOPE(zone) ((void)0)
+#else
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(zone) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(ProfileZone::zone)
+#endif
+
+#endif
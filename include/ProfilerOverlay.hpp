@@ -0,0 +1,31 @@
+#ifndef PROFILER_OVERLAY_HPP
+#define PROFILER_OVERLAY_HPP
+
+#include <SFML/Graphics.hpp>
+#include "Profiler.hpp"
+
+// Top-right panel listing rolling min/avg/p99 per profiler zone. Drawn
+// through the UI view; the text is only rebuilt a few times a second so
+// the overlay doesn't show up in its own numbers.
+class ProfilerOverlay {
+public:
+    static constexpr float refreshInterval = 0.25f;
+    static constexpr std::size_t windowFrames = 240;
+
+    ProfilerOverlay(const sf::Font& font, const sf::Vector2f& windowSize);
+
+    bool visible = false;
+
+    void update(float dt);
+    void draw(sf::RenderWindow& window) const;
+
+private:
+    sf::Vector2f windowSize;
+    sf::RectangleShape panel;
+    sf::Text text;
+    float refreshTimer = refreshInterval;
+
+    void rebuild();
+};
+
+#endif // PROFILER_OVERLAY_HPP
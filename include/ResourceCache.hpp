@@ -0,0 +1,102 @@
+#ifndef RESOURCE_CACHE_HPP
+#define RESOURCE_CACHE_HPP
+
+#include <SFML/Graphics.hpp>
+#include <SFML/Audio.hpp>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+
+// One decoded copy of every texture, sound buffer and font, keyed by path.
+// Callers get a ResourceHandle, which is a ref-counted pointer to the cached
+// entry. Resolve it once at set-up and deref it on hot paths; that costs one
+// pointer load, with no lookup or locking.
+//
+// The cache keeps its own reference, so an asset stays resident after its
+// last user goes away, and a restart or a new HUD/renderer reuses it without
+// touching the disk. Call purgeUnused() to drop the assets nobody holds.
+// A failed load is cached too: it logs once and hands out an empty resource,
+// just like the loadFromFile-and-carry-on code this replaces.
+//
+// Images are CPU-side pixels for code that packs or edits them (the
+// background atlas); draw with textures. AssetLoader decodes on worker
+// threads and hands the results over with adopt(), so later lookups hit.
+
+template <typename T>
+class ResourceHandle {
+public:
+    struct Entry {
+        T resource;
+        std::string path;
+        bool loaded = false;
+        std::size_t bytes = 0; // Estimated resident size
+    };
+
+    ResourceHandle() = default;
+    explicit ResourceHandle(std::shared_ptr<const Entry> entry) : entry(std::move(entry)) {}
+
+    const T& operator*() const { return entry->resource; }
+    const T* operator->() const { return &entry->resource; }
+    const T& get() const { return entry->resource; }
+
+    bool valid() const { return entry != nullptr; }
+    bool loaded() const { return entry && entry->loaded; }
+    const std::string& path() const { return entry->path; }
+
+private:
+    std::shared_ptr<const Entry> entry;
+};
+
+class ResourceCache {
+public:
+    static ResourceCache& instance();
+
+    ResourceHandle<sf::Texture> texture(const std::string& path);
+    ResourceHandle<sf::Image> image(const std::string& path);
+    ResourceHandle<sf::SoundBuffer> soundBuffer(const std::string& path);
+    ResourceHandle<sf::Font> font(const std::string& path);
+
+    // Stores a resource loaded elsewhere under path. Returns false and keeps
+    // the cached copy if the path was already there. Textures must still be
+    // adopted from the thread that owns the GL context.
+    bool adopt(const std::string& path, sf::Texture&& texture);
+    bool adopt(const std::string& path, sf::Image&& image);
+    bool adopt(const std::string& path, sf::SoundBuffer&& buffer);
+    bool adopt(const std::string& path, sf::Font&& font);
+
+    // Frees every asset held only by the cache; returns how many went
+    std::size_t purgeUnused();
+
+    // Drops every cached reference. Assets still held elsewhere live until
+    // their last handle goes. Call before the window closes, so textures
+    // and fonts aren't released after the GL context is gone.
+    void clear();
+
+    std::size_t residentBytes() const;
+
+    // One line per asset: kind, users, estimated size, path
+    void report(std::ostream& out) const;
+
+private:
+    ResourceCache() = default;
+
+    template <typename T>
+    using Table = std::unordered_map<std::string, std::shared_ptr<typename ResourceHandle<T>::Entry>>;
+
+    mutable std::mutex mutex;
+    Table<sf::Texture> textures;
+    Table<sf::Image> images;
+    Table<sf::SoundBuffer> soundBuffers;
+    Table<sf::Font> fonts;
+
+    template <typename T>
+    ResourceHandle<T> acquire(Table<T>& table, const std::string& path);
+
+    template <typename T>
+    bool insert(Table<T>& table, const std::string& path, T&& resource);
+};
+
+#endif // RESOURCE_CACHE_HPP
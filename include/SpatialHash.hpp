@@ -0,0 +1,136 @@
+#ifndef SPATIALHASH_HPP
+#define SPATIALHASH_HPP
+#include <SFML/System/Vector2.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+// Uniform grid over an unbounded world. Cells are hashed into a flat bucket
+// table that is rebuilt from scratch each tick: insert everything, build(),
+// then query. Queries hand back candidate ids and leave the exact test to
+// the caller. Items are stored by centre and may be up to one cell across.
+class SpatialHash {
+public:
+    explicit SpatialHash(float cellSize = 128.f) : cellSize(cellSize), invCellSize(1.f / cellSize) {}
+
+    void clear() { staged.clear(); }
+    void reserve(std::size_t n) { staged.reserve(n); }
+
+    // Each item is stored once, in the cell holding its centre
+    void insert(std::uint32_t id, sf::Vector2f center) {
+        staged.push_back({cellKey(cellOf(center.x), cellOf(center.y)), id});
+    }
+
+    // Sorts the staged entries into buckets; call once after inserting
+    void build();
+
+    // Calls fn(id) for every item whose centre cell overlaps the circle
+    template <typename Fn>
+    void forEachInRadius(sf::Vector2f center, float radius, Fn &&fn) const {
+        if (entries.empty()) return;
+        int x0 = cellOf(center.x - radius), x1 = cellOf(center.x + radius);
+        int y0 = cellOf(center.y - radius), y1 = cellOf(center.y + radius);
+        for (int cy = y0; cy <= y1; ++cy)
+            for (int cx = x0; cx <= x1; ++cx)
+                forEachInCell(cx, cy, fn);
+    }
+
+    // Walks the cells under the ray in order (Amanatides-Woo DDA) and asks
+    // test(id, distance) about everything stored in or next to them, since
+    // an item centred one cell over can still overlap the beam. Stops as
+    // soon as the nearest hit so far lies inside the cells already walked.
+    // Returns the nearest id, or noHit, and writes its distance.
+    static constexpr std::uint32_t noHit = std::numeric_limits<std::uint32_t>::max();
+
+    template <typename Test>
+    std::uint32_t raycast(sf::Vector2f origin, sf::Vector2f dir, float maxDistance, float &hitDistance, Test &&test) const {
+        std::uint32_t best = noHit;
+        float bestDistance = maxDistance;
+        if (entries.empty()) return best;
+
+        const float inf = std::numeric_limits<float>::infinity();
+        int cx = cellOf(origin.x), cy = cellOf(origin.y);
+        int stepX = dir.x > 0.f ? 1 : -1;
+        int stepY = dir.y > 0.f ? 1 : -1;
+        float tDeltaX = dir.x != 0.f ? cellSize / std::abs(dir.x) : inf;
+        float tDeltaY = dir.y != 0.f ? cellSize / std::abs(dir.y) : inf;
+        float tMaxX = dir.x != 0.f ? ((cx + (stepX > 0)) * cellSize - origin.x) / dir.x : inf;
+        float tMaxY = dir.y != 0.f ? ((cy + (stepY > 0)) * cellSize - origin.y) / dir.y : inf;
+
+        auto visit = [&](std::uint32_t id) {
+            float distance = 0.f;
+            if (test(id, distance) && distance < bestDistance) {
+                bestDistance = distance;
+                best = id;
+            }
+        };
+
+        for (int dy = -1; dy <= 1; ++dy)
+            for (int dx = -1; dx <= 1; ++dx)
+                forEachInCell(cx + dx, cy + dy, visit);
+
+        while (true) {
+            float tExit = std::min(tMaxX, tMaxY);
+            // Anything not yet tested is hit no earlier than tExit
+            if (bestDistance <= tExit || tExit > maxDistance) break;
+            // The walk is monotonic, so only the leading row or column of
+            // the 3x3 neighbourhood is new
+            if (tMaxX < tMaxY) {
+                cx += stepX;
+                tMaxX += tDeltaX;
+                for (int dy = -1; dy <= 1; ++dy) forEachInCell(cx + stepX, cy + dy, visit);
+            } else {
+                cy += stepY;
+                tMaxY += tDeltaY;
+                for (int dx = -1; dx <= 1; ++dx) forEachInCell(cx + dx, cy + stepY, visit);
+            }
+        }
+
+        if (best != noHit) hitDistance = bestDistance;
+        return best;
+    }
+
+private:
+    struct Entry {
+        std::uint64_t key;
+        std::uint32_t id;
+    };
+
+    float cellSize;
+    float invCellSize;
+    std::vector<Entry> staged;
+    std::vector<Entry> entries; // staged, grouped by bucket
+    std::vector<std::uint32_t> bucketStart; // bucketCount + 1 offsets into entries
+    std::vector<std::uint32_t> scatterCursor;
+    unsigned bucketBits = 0;
+
+    // floor() without the libm call
+    int cellOf(float v) const {
+        float f = v * invCellSize;
+        int i = static_cast<int>(f);
+        return i - (f < static_cast<float>(i));
+    }
+
+    static std::uint64_t cellKey(int cx, int cy) {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(cx)) << 32) | static_cast<std::uint32_t>(cy);
+    }
+
+    std::size_t bucketOf(std::uint64_t key) const {
+        return static_cast<std::size_t>((key * 0x9E3779B97F4A7C15ull) >> (64 - bucketBits));
+    }
+
+    template <typename Fn>
+    void forEachInCell(int cx, int cy, Fn &&fn) const {
+        std::uint64_t key = cellKey(cx, cy);
+        std::size_t b = bucketOf(key);
+        for (std::uint32_t e = bucketStart[b]; e < bucketStart[b + 1]; ++e) {
+            // Skip other cells that happen to share the bucket
+            if (entries[e].key == key) fn(entries[e].id);
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef SPRITE_BATCH_HPP
+#define SPRITE_BATCH_HPP
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+
+// Collects textured quads (and flat circles) for a frame, then draws them
+// sorted by layer, texture and blend mode. Each run of equal state is one
+// draw call out of a single streaming vertex buffer. Within a run items keep
+// their submission order. Lower layers draw first.
+class SpriteBatch {
+public:
+    SpriteBatch();
+
+    void clear();
+
+    // Uses the sprite's current texture, rect, transform and colour
+    void add(int layer, const sf::Sprite& sprite, const sf::BlendMode& blend = sf::BlendAlpha);
+
+    // Same quad without building an sf::Sprite; rotation in degrees
+    void add(int layer, const sf::Texture& texture, const sf::IntRect& rect, sf::Vector2f position,
+             sf::Vector2f origin, sf::Vector2f scale, sf::Color color = sf::Color::White,
+             float rotation = 0.f, const sf::BlendMode& blend = sf::BlendAlpha);
+
+    // Untextured filled circle, like a default sf::CircleShape
+    void addCircle(int layer, sf::Vector2f center, float radius, sf::Color color, unsigned pointCount = 30,
+                   const sf::BlendMode& blend = sf::BlendAlpha);
+
+    // Sorts, uploads and draws everything, then clears
+    void flush(sf::RenderTarget& target);
+
+    // Draw calls issued by the last flush
+    std::size_t drawCalls() const { return lastDrawCalls; }
+
+private:
+    struct Item {
+        int layer;
+        const sf::Texture* texture;
+        std::uint8_t blend;  // Index into blends
+        std::uint32_t first; // Into staging
+        std::uint32_t count;
+    };
+
+    std::vector<Item> items;
+    std::vector<sf::BlendMode> blends; // Distinct modes seen, usually one
+    std::vector<sf::Vertex> staging;   // Submission order
+    std::vector<sf::Vertex> sorted;    // Draw order
+    sf::VertexBuffer buffer;
+    std::size_t lastDrawCalls = 0;
+
+    std::uint8_t blendIndex(const sf::BlendMode& blend);
+    void pushQuad(int layer, const sf::Texture* texture, std::uint8_t blend, const sf::Vector2f (&corners)[4],
+                  const sf::IntRect& rect, sf::Color color);
+};
+
+#endif // SPRITE_BATCH_HPP
@@ -0,0 +1,41 @@
+#ifndef SPSC_QUEUE_HPP
+#define SPSC_QUEUE_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+// Fixed-size single-producer/single-consumer ring. One thread pushes, one
+// thread pops, and neither ever blocks or takes a lock.
+template <typename T, std::size_t Capacity>
+class SpscQueue {
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    // Producer side. Leaves value untouched and returns false when full.
+    bool push(T& value) {
+        std::size_t tail = writeIndex.load(std::memory_order_relaxed);
+        if (tail - readIndex.load(std::memory_order_acquire) == Capacity) return false;
+        slots[tail & (Capacity - 1)] = std::move(value);
+        writeIndex.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side
+    bool pop(T& out) {
+        std::size_t head = readIndex.load(std::memory_order_relaxed);
+        if (head == writeIndex.load(std::memory_order_acquire)) return false;
+        out = std::move(slots[head & (Capacity - 1)]);
+        readIndex.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    std::array<T, Capacity> slots{};
+    // Separate cache lines so producer and consumer don't false-share
+    alignas(64) std::atomic<std::size_t> readIndex{0};
+    alignas(64) std::atomic<std::size_t> writeIndex{0};
+};
+
+#endif // SPSC_QUEUE_HPP
@@ -0,0 +1,31 @@
+#ifndef TEXTURE_ATLAS_HPP
+#define TEXTURE_ATLAS_HPP
+
+#include <SFML/Graphics.hpp>
+#include <string>
+#include <vector>
+
+// Packs several images into one texture so everything drawn from them can
+// share a single draw call. Add every image first, then build() once.
+class TextureAtlas {
+public:
+    // Returns the region index, or -1 if the file couldn't be loaded
+    int addFromFile(const std::string& path);
+    int add(const sf::Image& image);
+
+    // Shelf-packs the images (tallest first) and uploads the texture
+    bool build(unsigned maxWidth = 2048);
+
+    const sf::Texture& getTexture() const { return texture; }
+    sf::IntRect getRegion(int index) const { return regions[index]; }
+    std::size_t size() const { return regions.size(); }
+
+private:
+    static constexpr unsigned padding = 2; // Keeps neighbours from bleeding when filtered
+
+    std::vector<sf::Image> pending;
+    std::vector<sf::IntRect> regions;
+    sf::Texture texture;
+};
+
+#endif // TEXTURE_ATLAS_HPP
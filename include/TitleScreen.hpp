@@ -3,6 +3,7 @@
 
 #include <SFML/Graphics.hpp>
 #include <SFML/Audio.hpp>
+#include "ResourceCache.hpp"
 #include <vector>
 #include <string>
 
@@ -20,15 +21,15 @@ public:
     void draw(sf::RenderWindow& window);
 
 private:
-    sf::Font font;
-    sf::Texture titleTexture;
+    ResourceHandle<sf::Font> font;
+    ResourceHandle<sf::Texture> titleTexture;
     sf::Sprite titleSprite;
     std::vector<sf::Text> options;
     std::vector<std::string> optionLabels;
     int selectedOption;
     
     // Audio
-    sf::SoundBuffer clickBuffer;
+    ResourceHandle<sf::SoundBuffer> clickBuffer;
     sf::Sound clickSound;
 
     // Visual effects
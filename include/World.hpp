@@ -0,0 +1,137 @@
+#ifndef WORLD_HPP
+#define WORLD_HPP
+
+#include <SFML/System/Vector2.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <cstdint>
+#include <vector>
+#include "Random.hpp"
+#include <memory>
+#include "player.hpp"
+#include "Enemy.hpp"
+#include "Coin.hpp"
+#include "effects.hpp"
+#include "SpatialHash.hpp"
+#include "JobSystem.hpp"
+#include "GameEvents.hpp"
+
+// Everything the simulation needs from the keyboard/mouse for one tick.
+// Sampled once per rendered frame and fed to every tick that frame runs.
+struct PlayerInput {
+    bool up = false;
+    bool down = false;
+    bool left = false;
+    bool right = false;
+    bool nitro = false;
+    bool fire = false;
+    bool shockwave = false;
+    bool repair = false;
+    sf::Vector2f aim; // World-space aim point
+};
+
+// GAME-state simulation, stepped at a fixed rate independent of rendering.
+// Holds no textures, sprites or sounds, so it also runs headless.
+class World {
+public:
+    static constexpr float tickRate = 60.f;
+    static constexpr float tickDt = 1.f / tickRate;
+    // Longest real frame we try to catch up on; anything above is dropped
+    // so a stall can't spiral into hundreds of ticks.
+    static constexpr float maxFrameTime = 0.25f;
+
+    static constexpr float orbDropProbability = 0.25f;
+    static constexpr int repairCost = 500;
+    static constexpr float maxLaserLength = 2000.f;
+    static constexpr float laserDamagePerTick = 2.f; // Continuous fire
+    // Resting coins are only checked for despawn this often
+    static constexpr std::uint64_t coinDespawnInterval = 30;
+    // Resting coins above this get merged more aggressively on the sweep
+    static constexpr std::size_t maxRestingCoins = 192;
+    static constexpr std::size_t coinJobGrain = 256; // Coins per homing job
+
+    World(sf::Vector2f viewSize);
+
+    // Enemy count ramps from base towards base*difficulty, capped at max.
+    // Raise both for swarm modes; the pool is sized for it on reset().
+    std::size_t baseEnemyCount = 4;
+    std::size_t maxEnemyCount = 32;
+
+    // Reseeds every random stream the simulation draws from (see
+    // RngStream). With the same seed, settings and inputs, a run repeats
+    // tick for tick.
+    void seed(std::uint32_t masterSeed);
+    void reset(sf::Vector2f spawnPos);
+    void step(const PlayerInput& input);
+
+    // Camera rectangle around the player at the current tick
+    sf::FloatRect getViewBounds(float margin = 0.f) const;
+
+    // FNV-1a over the gameplay state (player, enemies, pickups, counters),
+    // for spotting where two runs of the same recording part ways
+    std::uint64_t stateHash() const;
+
+    std::unique_ptr<Player> player;
+    EnemyPool enemies;
+    std::vector<Coin> coins;
+    std::vector<ShockwaveOrb> orbs;
+    std::vector<ShockwaveRipple> shockwaveRipples;
+    // Stepped with the world but fed by WorldEffects from events; only
+    // the thruster trail is emitted by the simulation itself
+    ParticleSystem particleSystem;
+    ScreenShake screenShake;
+
+    // Broadphase grids, rebuilt every tick
+    SpatialHash enemyGrid;
+    SpatialHash coinGrid;
+
+    sf::Vector2f viewSize;      // Size of the camera rectangle used for spawning/culling
+    sf::Vector2f cameraCenter;  // Follows the player each tick
+    int totalCoins = 0;          // Sum of collected coin values
+    float difficulty = 1.f;
+    float elapsed = 0.f;       // Simulated seconds since reset
+    std::uint64_t tick = 0;
+    bool gameOver = false;
+
+    // Laser impact this tick, for the hit splash
+    bool laserHitting = false;
+    sf::Vector2f laserHitPos;
+    float laserHitAngle = 0.f;
+
+    // What happened during the ticks since the last dispatch. The world
+    // only publishes; the caller dispatches once per frame to whoever
+    // reacts (WorldEffects, sound, popups, counters).
+    GameEvents events;
+
+private:
+    float difficultyTimeOffset = 0.f;
+    PlayerInput lastInput;
+    Rng rng;
+    // Coins before this index were there at the last pickup pass; later
+    // ones are fresh drops that still need merging
+    std::size_t settledCoins = 0;
+
+    // Enemy flag events found by the parallel scan, applied in order after
+    struct EnemyEvent {
+        enum Kind : std::uint8_t { Kill, Recycle, Explode } kind;
+        std::uint32_t index;
+    };
+    CommandBuffers<EnemyEvent> enemyEvents;
+
+    void updatePlayer(const PlayerInput& input);
+    void fireLaser(const PlayerInput& input);
+    void updatePickups();
+    bool mergeCoin(std::size_t i, float radius);
+    void clusterCoins();
+    void updateEnemies();
+    void killEnemy(std::size_t i);
+};
+
+// Slab test of a ray against an axis-aligned box; distance is where it enters
+bool rayBoxIntersect(sf::Vector2f rayOrigin, sf::Vector2f rayDir, sf::FloatRect box, float& distance);
+
+// Position an entity should be drawn at, between its last two ticks
+inline sf::Vector2f interpolate(sf::Vector2f prev, sf::Vector2f curr, float alpha) {
+    return prev + (curr - prev) * alpha;
+}
+
+#endif
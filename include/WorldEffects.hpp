@@ -0,0 +1,29 @@
+#ifndef WORLD_EFFECTS_HPP
+#define WORLD_EFFECTS_HPP
+
+#include <cstddef>
+
+class World;
+
+// Particle bursts and screen shake for gameplay events, kept out of the
+// simulation. Subscribes to world.events and feeds world.particleSystem
+// and world.screenShake once per dispatch:
+//  - kills near each other share one burst, up to maxKillBursts per frame,
+//  - shake is added once per event type, capped, however many events came in.
+// The game and lss_headless both subscribe, so their particle load matches.
+namespace WorldEffects {
+
+constexpr float burstMergeRadius = 160.f;
+constexpr std::size_t maxKillBursts = 8;
+constexpr int particlesPerKill = 20;
+constexpr int maxBurstParticles = 60;
+constexpr float killTrauma = 0.4f;
+constexpr float maxKillTrauma = 0.8f;
+constexpr float hitTrauma = 0.8f;
+constexpr float laserTrauma = 0.01f; // Per tick of fire
+
+void subscribe(World& world);
+
+} // namespace WorldEffects
+
+#endif // WORLD_EFFECTS_HPP
@@ -0,0 +1,64 @@
+#ifndef WORLD_RENDERER_HPP
+#define WORLD_RENDERER_HPP
+
+#include <SFML/Graphics.hpp>
+#include "World.hpp"
+#include "effects.hpp"
+#include "ResourceCache.hpp"
+#include "SpriteBatch.hpp"
+
+// Owns every gameplay texture and builds sprite transforms from World state
+// at draw time. The World itself never touches SFML graphics.
+class WorldRenderer {
+public:
+    WorldRenderer();
+
+    // Per-frame animation that isn't part of the simulation (hit splash)
+    void update(const World& world, float dt);
+
+    // Draws the world entities using the current view; alpha blends between
+    // the previous and current tick positions.
+    void draw(sf::RenderWindow& window, const World& world, float alpha);
+    void drawEnemies(sf::RenderWindow& window, const World& world, float alpha);
+
+    // Fills out with two triangles per live particle and returns the vertex
+    // count; out needs room for capacity() * 6
+    static std::size_t buildParticleVertices(const ParticleSystem& particles, sf::Vertex* out);
+
+private:
+    // Textures must be declared before Sprites to ensure they are initialized first
+    ResourceHandle<sf::Texture> playerInitial;
+    ResourceHandle<sf::Texture> playerAccel;
+    ResourceHandle<sf::Texture> playerBoost;
+    ResourceHandle<sf::Texture> enemyInitial;
+    ResourceHandle<sf::Texture> enemyExplosion;
+    ResourceHandle<sf::Texture> coinTexture;
+    ResourceHandle<sf::Texture> laserTexture;
+
+    sf::Sprite playerSprite;
+    sf::Sprite enemySprite;
+    sf::Sprite coinSprite;
+    sf::Sprite laserSprite;
+    sf::CircleShape orbShape;
+    HitSplash hitSplash;
+
+    // Particle quads are rebuilt into one persistent streaming buffer
+    std::vector<sf::Vertex> particleVertices;
+    sf::VertexBuffer particleBuffer;
+
+    // Every enemy trail as line segments, one buffer and one draw
+    std::vector<sf::Vertex> trailVertices;
+    sf::VertexBuffer trailBuffer;
+
+    // Sprites and orbs are gathered per frame and drawn a run per texture.
+    // The sprites above only carry the shared origin/scale/rect set-up.
+    enum Layer { LaserLayer, OrbLayer, CoinLayer, PlayerLayer, EnemyLayer, SplashLayer };
+    SpriteBatch batch;
+
+    void batchPlayer(const Player& player, float alpha);
+    void batchEnemies(const World& world, float alpha);
+    void drawParticles(sf::RenderWindow& window, const ParticleSystem& particles);
+    void drawTrails(sf::RenderWindow& window, const EnemyPool& enemies);
+};
+
+#endif // WORLD_RENDERER_HPP
@@ -2,14 +2,17 @@
 #define EFFECTS_HPP
 
 #include <SFML/Graphics.hpp>
+#include "ResourceCache.hpp"
+#include "JobSystem.hpp"
+#include "Random.hpp"
 #include <vector>
 #include <cmath>
-#include <random>
 #include <algorithm>
 #include <cstdint>
-#include <deque>
-#include <iostream>
 
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
 
 
 class ScreenShake {
@@ -17,15 +20,11 @@ public:
     float trauma = 0.f;
     float maxOffset = 10.f; 
     sf::Vector2f shakeDir = {1.f, 0.f};
-    std::mt19937 rng;
-
-    ScreenShake() : rng(std::random_device{}()) {}
+    Rng rng;
 
     void addTrauma(float amount) {
         if (trauma <= 0.01f) {
-            std::uniform_int_distribution<int> dist(0, 3);
-            int dir = dist(rng);
-            switch (dir) {
+            switch (rng.below(4)) {
                 case 0: shakeDir = {1.f, 0.f}; break; // Horizontal
                 case 1: shakeDir = {0.f, 1.f}; break; // Vertical
                 case 2: shakeDir = {0.707f, 0.707f}; break; // Diagonal
@@ -56,109 +55,131 @@ private:
     }
 };
 
-struct Particle {
-    sf::Vector2f position;
-    sf::Vector2f velocity;
-    float lifetime;
-    float maxLifetime;
-    sf::Color color;
-};
-
+// Fixed-capacity particle pool stored as parallel arrays. Nothing is
+// allocated after construction: emitting into a full pool drops the new
+// particles, and dead ones are removed by swapping in the last live one.
+// Drawing lives in WorldRenderer so the pool stays headless.
 class ParticleSystem {
 public:
-    std::vector<Particle> particles;
-    std::mt19937 rng;
+    static constexpr std::size_t defaultCapacity = 1 << 17; // Keep a multiple of 4
 
-    ParticleSystem() : rng(std::random_device{}()) {}
+    std::vector<float> posX, posY;
+    std::vector<float> velX, velY;
+    std::vector<float> lifetime, maxLifetime;
+    std::vector<sf::Color> color;
+    Rng rng;
 
-    void emit(sf::Vector2f position, int count, sf::Color color, float speed = 100.f) {
-        std::uniform_real_distribution<float> angleDist(0.f, 2.f * 3.14159f);
-        std::uniform_real_distribution<float> speedDist(speed * 0.5f, speed * 1.5f);
-        std::uniform_real_distribution<float> lifeDist(0.3f, 0.8f);
+    explicit ParticleSystem(std::size_t capacity = defaultCapacity)
+        : posX(capacity), posY(capacity), velX(capacity), velY(capacity),
+          lifetime(capacity), maxLifetime(capacity), color(capacity) {}
+
+    std::size_t size() const { return liveCount; }
+    std::size_t capacity() const { return posX.size(); }
+    bool empty() const { return liveCount == 0; }
+    void clear() { liveCount = 0; }
 
+    void emit(sf::Vector2f position, int count, sf::Color color, float speed = 100.f) {
         for (int i = 0; i < count; ++i) {
-            float angle = angleDist(rng);
-            float s = speedDist(rng);
-            sf::Vector2f vel = {std::cos(angle) * s, std::sin(angle) * s};
-            particles.push_back({position, vel, lifeDist(rng), lifeDist(rng), color});
+            float angle = rng.uniform(0.f, 2.f * 3.14159f);
+            float s = rng.uniform(speed * 0.5f, speed * 1.5f);
+            float life = rng.uniform(0.3f, 0.8f);
+            float maxLife = rng.uniform(0.3f, 0.8f);
+            if (!add(position, {std::cos(angle) * s, std::sin(angle) * s}, life, maxLife, color)) break;
         }
     }
 
     void emitCone(sf::Vector2f position, sf::Vector2f direction, float coneAngle, int count, sf::Color color, float speed = 100.f) {
         float baseAngle = std::atan2(direction.y, direction.x);
         float halfAngle = coneAngle / 2.f;
-        std::uniform_real_distribution<float> angleDist(baseAngle - halfAngle, baseAngle + halfAngle);
-        std::uniform_real_distribution<float> speedDist(speed * 0.8f, speed * 1.2f);
-        std::uniform_real_distribution<float> lifeDist(0.2f, 0.6f);
 
         for (int i = 0; i < count; ++i) {
-            float angle = angleDist(rng);
-            float s = speedDist(rng);
-            sf::Vector2f vel = {std::cos(angle) * s, std::sin(angle) * s};
-            particles.push_back({position, vel, lifeDist(rng), lifeDist(rng), color});
+            float angle = rng.uniform(baseAngle - halfAngle, baseAngle + halfAngle);
+            float s = rng.uniform(speed * 0.8f, speed * 1.2f);
+            float life = rng.uniform(0.2f, 0.6f);
+            float maxLife = rng.uniform(0.2f, 0.6f);
+            if (!add(position, {std::cos(angle) * s, std::sin(angle) * s}, life, maxLife, color)) break;
         }
     }
 
+    static constexpr std::size_t jobGrain = 4096; // Particles per job; keep a multiple of 4
+
     void update(float dt) {
-        for (auto& p : particles) {
-            p.lifetime -= dt;
-            p.position += p.velocity * dt;
+        // Integrate whole blocks of 4 (tail lanes are free slots, so
+        // touching them is harmless). Chunks are independent, so they run
+        // on the job system; the compaction below stays serial.
+        std::size_t padded = std::min((liveCount + 3) & ~std::size_t{3}, capacity());
+        JobSystem::instance().parallelFor(padded, jobGrain, [&](std::size_t begin, std::size_t end, std::size_t) {
+            integrate(begin, end, dt);
+        });
+
+        // Swap-and-pop; the swapped-in particle is checked on the same index
+        std::size_t i = 0;
+        while (i < liveCount) {
+            if (lifetime[i] > 0.f) {
+                ++i;
+                continue;
+            }
+            std::size_t last = --liveCount;
+            posX[i] = posX[last];
+            posY[i] = posY[last];
+            velX[i] = velX[last];
+            velY[i] = velY[last];
+            lifetime[i] = lifetime[last];
+            maxLifetime[i] = maxLifetime[last];
+            color[i] = color[last];
         }
-
-        particles.erase(std::remove_if(particles.begin(), particles.end(),
-            [](const Particle& p) { return p.lifetime <= 0.f; }),
-            particles.end());
     }
 
-    void draw(sf::RenderWindow& window) {
-        sf::VertexArray va(sf::PrimitiveType::Triangles, particles.size() * 6); 
-        
-        float size = 4.f; 
-
-        for (size_t i = 0; i < particles.size(); ++i) {
-            const auto& p = particles[i];
-            
-            sf::Color c = p.color;
-            float alpha = (p.lifetime / p.maxLifetime) * 255.f;
-            c.a = static_cast<std::uint8_t>(alpha);
-
-            size_t idx = i * 6;
-            
-            float half = size / 2.f;
-            sf::Vector2f pos = p.position;
-
-            va[idx + 0].position = {pos.x - half, pos.y - half};
-            va[idx + 1].position = {pos.x + half, pos.y - half};
-            va[idx + 2].position = {pos.x - half, pos.y + half};
-            
-            va[idx + 3].position = {pos.x + half, pos.y - half};
-            va[idx + 4].position = {pos.x + half, pos.y + half};
-            va[idx + 5].position = {pos.x - half, pos.y + half};
-
-            for(int j=0; j<6; ++j) va[idx+j].color = c;
+private:
+    std::size_t liveCount = 0;
+
+    void integrate(std::size_t begin, std::size_t end, float dt) {
+#if defined(__SSE2__) || defined(_M_X64)
+        const __m128 vdt = _mm_set1_ps(dt);
+        for (std::size_t i = begin; i < end; i += 4) {
+            _mm_storeu_ps(&lifetime[i], _mm_sub_ps(_mm_loadu_ps(&lifetime[i]), vdt));
+            _mm_storeu_ps(&posX[i], _mm_add_ps(_mm_loadu_ps(&posX[i]), _mm_mul_ps(_mm_loadu_ps(&velX[i]), vdt)));
+            _mm_storeu_ps(&posY[i], _mm_add_ps(_mm_loadu_ps(&posY[i]), _mm_mul_ps(_mm_loadu_ps(&velY[i]), vdt)));
         }
-        window.draw(va);
+#else
+        for (std::size_t i = begin; i < end; ++i) {
+            lifetime[i] -= dt;
+            posX[i] += velX[i] * dt;
+            posY[i] += velY[i] * dt;
+        }
+#endif
+    }
+
+    bool add(sf::Vector2f position, sf::Vector2f velocity, float life, float maxLife, sf::Color c) {
+        if (liveCount == posX.size()) return false; // Pool is full
+        std::size_t i = liveCount++;
+        posX[i] = position.x;
+        posY[i] = position.y;
+        velX[i] = velocity.x;
+        velY[i] = velocity.y;
+        lifetime[i] = life;
+        maxLifetime[i] = maxLife;
+        color[i] = c;
+        return true;
     }
 };
 
 
 class HitSplash {
 public:
+    // Textures must be declared before Sprite to ensure they are initialized first
+    ResourceHandle<sf::Texture> t1, t2, t3;
     sf::Sprite sprite;
-    inline static sf::Texture t1, t2, t3;
-    inline static bool texturesLoaded = false;
     float timer = 0.f;
     int frame = 0;
     float frameDuration = 0.1f; // Speed of animation
 
-    HitSplash(sf::Vector2f position, float angle) : sprite(t1) {
-        if (!texturesLoaded) {
-            if (!t1.loadFromFile("resources/HitSplash/HS1.png")) std::cerr << "Failed to load HS1.png\n";
-            if (!t2.loadFromFile("resources/HitSplash/HS2.png")) std::cerr << "Failed to load HS2.png\n";
-            if (!t3.loadFromFile("resources/HitSplash/HS3.png")) std::cerr << "Failed to load HS3.png\n";
-            texturesLoaded = true;
-        }
-        sprite.setTexture(t1, true);
+    HitSplash(sf::Vector2f position, float angle)
+        : t1(ResourceCache::instance().texture("resources/HitSplash/HS1.png")),
+          t2(ResourceCache::instance().texture("resources/HitSplash/HS2.png")),
+          t3(ResourceCache::instance().texture("resources/HitSplash/HS3.png")),
+          sprite(*t1) {
+        sprite.setTexture(*t1, true);
         sf::FloatRect bounds = sprite.getLocalBounds();
         sprite.setOrigin({bounds.size.x / 2.f, bounds.size.y / 2.f});
         sprite.setPosition(position);
@@ -181,31 +202,25 @@ public:
             frame++;
             if (frame > 2) frame = 0; // Loop animation
             
-            if (frame == 0) sprite.setTexture(t1, true);
-            else if (frame == 1) sprite.setTexture(t2, true);
-            else if (frame == 2) sprite.setTexture(t3, true);
+            if (frame == 0) sprite.setTexture(*t1, true);
+            else if (frame == 1) sprite.setTexture(*t2, true);
+            else if (frame == 2) sprite.setTexture(*t3, true);
         }
     }
 };
 
 class ShockwaveRipple {
 public:
-    sf::CircleShape shape;
+    sf::Vector2f center;
     float lifetime = 0.f;
     float maxLifetime = 1.5f; // Slower duration
     float maxRadius = 1500.f; // Larger radius to ensure coverage
     float speed;
+    float currentRadius = 10.f;
     float currentThickness = 30.f;
     float currentAlpha = 255.f;
 
-    ShockwaveRipple(sf::Vector2f center) {
-        shape.setPosition(center);
-        shape.setRadius(10.f);
-        shape.setOrigin({10.f, 10.f});
-        shape.setFillColor(sf::Color::Transparent);
-        shape.setOutlineColor(sf::Color(0, 255, 255, 255)); // Cyan
-        shape.setOutlineThickness(30.f); 
-        
+    ShockwaveRipple(sf::Vector2f center) : center(center) {
         // Calculate speed to reach maxRadius in maxLifetime
         speed = maxRadius / maxLifetime;
     }
@@ -216,10 +231,7 @@ public:
 
         float progress = lifetime / maxLifetime;
         // Non-linear expansion for "powerful" feel
-        float currentRadius = speed * lifetime; 
-        
-        shape.setRadius(currentRadius);
-        shape.setOrigin({currentRadius, currentRadius});
+        currentRadius = speed * lifetime; 
 
         // Fade out
         currentAlpha = 255.f * (1.f - std::pow(progress, 2.f));
@@ -228,7 +240,13 @@ public:
         return true;
     }
 
-    void draw(sf::RenderWindow& window) {
+    // Shape is built at draw time so the ripple itself stays plain data
+    void draw(sf::RenderWindow& window) const {
+        sf::CircleShape shape(currentRadius);
+        shape.setOrigin({currentRadius, currentRadius});
+        shape.setPosition(center);
+        shape.setFillColor(sf::Color::Transparent);
+
         // Neon Glow Effect using Additive Blending
         
         // Pass 1: Wide, faint glow
@@ -254,96 +272,66 @@ public:
     }
 };
 
-#include <deque>
-
-// ... (existing includes)
-
-class FloatingText {
+// Position history for a whole pool of objects, indexed by slot. Every
+// slot owns a fixed ring of maxPoints samples inside one contiguous block,
+// so sampling never allocates and the renderer can walk all trails at once.
+class TrailPool {
 public:
-    sf::Text text;
-    float lifetime;
-    float maxLifetime;
-    sf::Vector2f velocity;
-
-    FloatingText(const sf::Font& font, const std::string& str, sf::Vector2f position, sf::Color color, float duration = 1.f)
-        : text(font), lifetime(duration), maxLifetime(duration) {
-        text.setString(str);
-        text.setCharacterSize(20);
-        text.setFillColor(color);
-        text.setOutlineColor(sf::Color::Black);
-        text.setOutlineThickness(1.f);
-        
-        sf::FloatRect bounds = text.getLocalBounds();
-        text.setOrigin({bounds.size.x / 2.f, bounds.size.y / 2.f});
-        text.setPosition(position);
-        
-        // Random slight horizontal drift, upward movement
-        static std::mt19937 rng(std::random_device{}());
-        std::uniform_real_distribution<float> drift(-30.f, 30.f);
-        velocity = {drift(rng), -50.f}; // Move up
+    static constexpr std::size_t maxPoints = 20;
+    static constexpr float interval = 0.02f; // Frequent sampling for smoothness
+
+    void resize(std::size_t slots) {
+        if (slots <= timers.size()) return;
+        points.resize(slots * maxPoints);
+        timers.resize(slots, 0.f);
+        heads.resize(slots, 0);
+        lengths.resize(slots, 0);
     }
 
-    bool update(float dt) {
-        lifetime -= dt;
-        if (lifetime <= 0.f) return false;
-
-        text.move(velocity * dt);
-        
-        float alpha = (lifetime / maxLifetime) * 255.f;
-        sf::Color c = text.getFillColor();
-        c.a = static_cast<std::uint8_t>(alpha);
-        text.setFillColor(c);
-        
-        sf::Color ox = text.getOutlineColor();
-        ox.a = static_cast<std::uint8_t>(alpha);
-        text.setOutlineColor(ox);
-
-        return true;
+    void reserve(std::size_t slots) {
+        points.reserve(slots * maxPoints);
+        timers.reserve(slots);
+        heads.reserve(slots);
+        lengths.reserve(slots);
     }
 
-    void draw(sf::RenderWindow& window) {
-        window.draw(text);
+    void clear(std::size_t slot) {
+        timers[slot] = 0.f;
+        lengths[slot] = 0;
     }
-};
 
-class Trail {
-public:
-    std::deque<sf::Vector2f> points;
-    float timer = 0.f;
-    float interval = 0.02f; // Frequent sampling for smoothness
-    int maxPoints = 20;
-
-    void update(sf::Vector2f pos, float dt) {
-        timer += dt;
-        if (timer >= interval) {
-            timer = 0.f;
-            points.push_front(pos);
-            if (points.size() > maxPoints) {
-                points.pop_back();
-            }
-        }
+    void clearAll() {
+        std::fill(timers.begin(), timers.end(), 0.f);
+        std::fill(lengths.begin(), lengths.end(), 0);
     }
 
-    void clear() {
-        points.clear();
-        timer = 0.f;
+    // Samples slots [begin, end) from SoA position arrays. Slots are
+    // independent, so disjoint ranges can be updated from different threads.
+    void update(const float* xs, const float* ys, std::size_t begin, std::size_t end, float dt) {
+        for (std::size_t i = begin; i < end; ++i) {
+            timers[i] += dt;
+            if (timers[i] < interval) continue;
+            timers[i] = 0.f;
+            std::uint8_t head = heads[i] + 1 == maxPoints ? 0 : heads[i] + 1;
+            heads[i] = head;
+            points[i * maxPoints + head] = {xs[i], ys[i]};
+            if (lengths[i] < maxPoints) lengths[i]++;
+        }
     }
 
-    void draw(sf::RenderWindow& window, sf::Color color) {
-        if (points.empty()) return;
+    std::size_t length(std::size_t slot) const { return lengths[slot]; }
 
-        sf::VertexArray va(sf::PrimitiveType::LineStrip, points.size());
-        for (std::size_t i = 0; i < points.size(); ++i) {
-            va[i].position = points[i];
-            
-            // Alpha fade
-            float ratio = 1.f - static_cast<float>(i) / points.size();
-            sf::Color c = color;
-            c.a = static_cast<std::uint8_t>(ratio * 150.f); 
-            va[i].color = c;
-        }
-        window.draw(va);
+    // k = 0 is the newest sample
+    sf::Vector2f point(std::size_t slot, std::size_t k) const {
+        std::size_t index = heads[slot] >= k ? heads[slot] - k : heads[slot] + maxPoints - k;
+        return points[slot * maxPoints + index];
     }
+
+private:
+    std::vector<sf::Vector2f> points;
+    std::vector<float> timers;
+    std::vector<std::uint8_t> heads;
+    std::vector<std::uint8_t> lengths;
 };
 
 
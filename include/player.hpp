@@ -1,12 +1,38 @@
 #ifndef PLAYER_HPP
 #define PLAYER_HPP
-#include <SFML/Graphics.hpp>
-#include <SFML/Graphics/Texture.hpp>
-#include <SFML/Graphics/Sprite.hpp>
-#include <SFML/System/Angle.hpp>
+#include <SFML/System/Vector2.hpp>
 #include <cmath>
+#include <cstdint>
 #include <algorithm>
-#include <iostream>
+#include <array>
+
+// One beam weapon fixed to the ship. It lives as long as the player: firing
+// refreshes its length from the raycast and holds it at full brightness,
+// and once firing stops a single timer fades it out. Its direction is the
+// ship's, turned by angleOffset, so it is never re-positioned.
+struct LaserBeam {
+    static constexpr float fadeTime = 0.15f; // Visible this long after the last shot
+
+    bool mounted = false;    // Whether this weapon slot has a beam at all
+    float angleOffset = 0.f; // Degrees from the nose, for spread weapons
+    float length = 0.f;
+    float fade = 0.f;        // Seconds of visibility left
+
+    void fire(float hitLength) {
+        length = hitLength;
+        fade = fadeTime;
+    }
+
+    void update(float dt) { fade = std::max(0.f, fade - dt); }
+
+    bool visible() const { return fade > 0.f; }
+
+    // Full brightness until the last 0.1 s, then fades out
+    std::uint8_t getAlpha() const {
+        int alpha = static_cast<int>((fade / 0.1f) * 255);
+        return static_cast<std::uint8_t>(std::clamp(alpha, 0, 255));
+    }
+};
 
 class Player{
     public:
@@ -30,14 +56,6 @@ class Player{
         float nitroRechargeRate = 22.f;
         bool nitroActive = false;
         
-        sf::Color color = sf::Color::Green;
-        
-        // Textures must be declared before Sprite to ensure they are initialized first
-        sf::Texture textureInitial;
-        sf::Texture textureAccel;
-        sf::Texture textureBoost;
-        sf::Sprite body;
-
         int maxHP = 1000;
         int HP = 1000;
         int shockwaveCharges = 0;
@@ -55,41 +73,39 @@ class Player{
         float laserRechargeDelay = 0.5f;
         float laserRechargeTimer = 0.f;
         bool isOverheated = false;
-        
-        Player(float startX, float startY) : body(textureInitial) {
-            if (!textureInitial.loadFromFile("resources/Player/Initial.png")) {
-                std::cerr << "Failed to load Initial.png" << std::endl;
-            }
-            if (!textureAccel.loadFromFile("resources/Player/OnAcceleration.png")) {
-                std::cerr << "Failed to load OnAcceleration.png" << std::endl;
-            }
-            if (!textureBoost.loadFromFile("resources/Player/OnBoost.png")) {
-                std::cerr << "Failed to load OnBoost.png" << std::endl;
-            }
+        bool wasShooting = false;
 
-            body.setTexture(textureInitial, true);
-            sf::FloatRect bounds = body.getLocalBounds();
-            body.setOrigin({bounds.size.x / 2.f, (bounds.size.y / 2.f)-12.f});
-            body.setPosition({startX,startY});
-        }
+        // Weapon slots; only the main gun (slot 0) is mounted for now
+        static constexpr std::size_t maxBeams = 4;
+        std::array<LaserBeam, maxBeams> beams = {LaserBeam{.mounted = true}};
 
-        void updateTexture(bool isMoving) {
+        sf::Vector2f position;
+        float rotation = 0.f; // Degrees, 0 = nose up
+
+        // Position at the previous simulation tick, for render interpolation
+        sf::Vector2f prevPosition;
+
+        // Which engine sprite the renderer should show
+        enum class Thrust { Idle, Accelerating, Boosting };
+        Thrust thrust = Thrust::Idle;
+        
+        Player(float startX, float startY) : position(startX, startY), prevPosition(position) {}
+
+        void updateThrust(bool isMoving) {
             if (nitroActive) {
-                body.setTexture(textureBoost, true);
+                thrust = Thrust::Boosting;
             } else if (isMoving) {
-                body.setTexture(textureAccel, true);
+                thrust = Thrust::Accelerating;
             } else {
-                body.setTexture(textureInitial, true);
+                thrust = Thrust::Idle;
             }
-            // Re-center origin as texture size might change
-            sf::FloatRect bounds = body.getLocalBounds();
-            body.setOrigin({bounds.size.x / 2.f, (bounds.size.y / 2.f)-12.f});
         }
 
+        // Velocities are in pixels per simulation tick (World::tickRate)
         void deaccelerate(float &vel,float &acc,bool forX=true,float friction=0.1f){
             vel += acc;
-            if(forX) body.move({vel,0.f});
-            else body.move({0.f,vel});
+            if(forX) position.x += vel;
+            else position.y += vel;
             acc = 0.f;
             if(vel != 0.f){
                 if(vel > 0.f){
@@ -109,11 +125,9 @@ class Player{
             }
         }
         void RotateTowards(const sf::Vector2f& target){
-            sf::Vector2f pos = body.getPosition();
-            float dx = target.x - pos.x;
-            float dy = target.y - pos.y;
-            float angle = std::atan2f(dy, dx) * (180.f / 3.14159265f) + 90.f;
-            body.setRotation(sf::degrees(angle));
+            float dx = target.x - position.x;
+            float dy = target.y - position.y;
+            rotation = std::atan2(dy, dx) * (180.f / 3.14159265f) + 90.f;
         }
         bool updateNitro(bool engage, float dt){
             if(engage && nitroCharge > 0.f){
@@ -207,75 +221,26 @@ class Player{
         
 };
 
-class Laser{
-    public:
-        sf::Sprite body;
-        inline static sf::Texture texture;
-        inline static bool textureLoaded = false;
-        inline static float initialLifetime = 0.15f; // Laser visible for 0.2 seconds
-        float lifetime = initialLifetime;
-
-        Laser(sf::Vector2f startPos, float angleDeg, float length) : body(texture) {
-            if(!textureLoaded){
-                if(!texture.loadFromFile("resources/Laser.png")){
-                    std::cerr << "Failed to load Laser.png" << std::endl;
-                }
-                // texture.setRepeated(true); // Disable repeat to avoid artifacts
-                textureLoaded = true;
-            }
-            // body.setTexture(texture); // Already set in initializer list
-            
-            // Crop the texture to the length required, but clamp to texture width (1400)
-            int rectWidth = std::min(static_cast<int>(length), 1400);
-            body.setTextureRect(sf::IntRect({0, 0}, {rectWidth, 150}));
-            
-            // Set origin to middle-left (start of beam)
-            // Adjusted to 40.f to center the beam visually
-            body.setOrigin({0.f, 17.f}); 
-            
-            body.setPosition(startPos);
-            body.setRotation(sf::degrees(angleDeg));
-            
-            // Scale down height to make it a beam, keep width (length) scale 1
-            // Increased thickness to 1.5f
-            body.setScale({1.f, 1.f}); 
-        }
-        
-        bool update(float dt){
-            lifetime -= dt;
-            // Fade out effect
-            int alpha = static_cast<int>((lifetime / 0.1f) * 255);
-            if(alpha < 0) alpha = 0;
-            body.setColor(sf::Color(255, 255, 255, alpha));
-            return lifetime > 0.f;
-        }
-};
-
 class ShockwaveOrb{
     public:
-        float speed = 8.f;
+        float speed = 480.f; // Pixels per second
+        sf::Vector2f prevPosition;
         float collectRadius = 30.f;  // Distance at which player can collect
-        sf::CircleShape body;
-        ShockwaveOrb(sf::Vector2f startPos){
-            body.setRadius(8.f);
-            body.setOrigin({8.f,8.f});
-            body.setPosition(startPos);
-            body.setFillColor(sf::Color::Cyan);
-        }
-        void update(const sf::Vector2f& playerPos){
+        float radius = 8.f;
+        sf::Vector2f position;
+        ShockwaveOrb(sf::Vector2f startPos) : prevPosition(startPos), position(startPos) {}
+        void update(const sf::Vector2f& playerPos, float dt){
             // Move towards player
-            sf::Vector2f pos = body.getPosition();
-            sf::Vector2f dir = playerPos - pos;
+            sf::Vector2f dir = playerPos - position;
             float len = std::sqrt(dir.x*dir.x + dir.y*dir.y);
             if(len > 0.0001f) {
                 dir.x /= len;
                 dir.y /= len;
-                body.move(dir * speed);
+                position += dir * speed * dt;
             }
         }
         bool isCollected(const sf::Vector2f& playerPos) const {
-            sf::Vector2f pos = body.getPosition();
-            sf::Vector2f diff = playerPos - pos;
+            sf::Vector2f diff = playerPos - position;
             float distanceSquared = diff.x * diff.x + diff.y * diff.y;
             return distanceSquared <= (collectRadius * collectRadius);
         }
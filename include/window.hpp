@@ -1,6 +1,7 @@
 #ifndef WINDOW_HPP
 #define WINDOW_HPP
 #include <SFML/Graphics.hpp> 
+#include "ResourceCache.hpp"
 #include <string>
 #include <algorithm>
 #include <vector>
@@ -14,10 +15,11 @@ class Window{
         sf::Vector2f center;
         sf::RenderWindow window;
         
-        sf::Font UiFont; 
-
         sf::View worldView;
         sf::View uiView;
+
+        ResourceHandle<sf::Font> UiFontHandle;
+        const sf::Font& UiFont;
         Window(const std::string& title);
 
         sf::FloatRect getViewBounds(float margin = 0.f) const{
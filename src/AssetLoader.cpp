@@ -0,0 +1,151 @@
+#include "AssetLoader.hpp"
+#include "ResourceCache.hpp"
+#include <SFML/Audio.hpp>
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+
+float millisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+const char* kindName(AssetLoader::Kind kind) {
+    switch (kind) {
+        case AssetLoader::Kind::Texture: return "texture";
+        case AssetLoader::Kind::Image: return "image";
+        case AssetLoader::Kind::SoundBuffer: return "sound";
+        case AssetLoader::Kind::Font: return "font";
+    }
+    return "?";
+}
+
+} // namespace
+
+AssetLoader::~AssetLoader() {
+    // Let the workers drain their current file; nothing new is handed out
+    nextJob = jobs.size();
+    for (auto& worker : workers) worker.join();
+}
+
+void AssetLoader::add(Kind kind, const std::string& path) {
+    jobs.emplace_back(kind, path);
+}
+
+void AssetLoader::start(unsigned threadCount) {
+    startTime = std::chrono::steady_clock::now();
+    if (threadCount == 0) {
+        unsigned cores = std::thread::hardware_concurrency();
+        threadCount = cores > 1 ? cores - 1 : 1;
+    }
+    threadCount = std::min<unsigned>(threadCount, static_cast<unsigned>(jobs.size()));
+    threadsUsed = threadCount;
+    for (unsigned i = 0; i < threadCount; ++i) {
+        workers.emplace_back(&AssetLoader::workerLoop, this);
+    }
+}
+
+void AssetLoader::workerLoop() {
+    while (true) {
+        std::size_t index = nextJob.fetch_add(1);
+        if (index >= jobs.size()) return;
+        decode(jobs[index]);
+    }
+}
+
+void AssetLoader::decode(Job& job) {
+    auto start = std::chrono::steady_clock::now();
+    ResourceCache& cache = ResourceCache::instance();
+
+    switch (job.kind) {
+        case Kind::Texture:
+            job.ok = job.image.loadFromFile(job.path);
+            break;
+        case Kind::Image: {
+            sf::Image image;
+            job.ok = image.loadFromFile(job.path);
+            if (job.ok) cache.adopt(job.path, std::move(image));
+            break;
+        }
+        case Kind::SoundBuffer: {
+            sf::SoundBuffer buffer;
+            job.ok = buffer.loadFromFile(job.path);
+            if (job.ok) cache.adopt(job.path, std::move(buffer));
+            break;
+        }
+        case Kind::Font: {
+            sf::Font font;
+            job.ok = font.openFromFile(job.path);
+            if (job.ok) cache.adopt(job.path, std::move(font));
+            break;
+        }
+    }
+
+    if (!job.ok) {
+        std::cerr << "Failed to load " << job.path << std::endl;
+    }
+    job.decodeMs = millisecondsSince(start);
+    job.decoded.store(true, std::memory_order_release);
+}
+
+void AssetLoader::update(float uploadBudgetMs) {
+    if (done()) return;
+
+    auto frameStart = std::chrono::steady_clock::now();
+    bool uploadedAny = false;
+
+    // Jobs finish out of order, so look at everything not yet finished
+    for (std::size_t i = finishedPrefix; i < jobs.size(); ++i) {
+        Job& job = jobs[i];
+        if (job.finished || !job.decoded.load(std::memory_order_acquire)) continue;
+
+        if (job.kind == Kind::Texture && job.ok) {
+            if (uploadedAny && millisecondsSince(frameStart) >= uploadBudgetMs) break;
+
+            auto start = std::chrono::steady_clock::now();
+            sf::Texture texture;
+            if (texture.loadFromImage(job.image)) {
+                ResourceCache::instance().adopt(job.path, std::move(texture));
+            } else {
+                std::cerr << "Failed to upload " << job.path << std::endl;
+            }
+            job.image = sf::Image(); // Free the pixels now the GPU has them
+            job.uploadMs = millisecondsSince(start);
+            uploadedAny = true;
+        }
+
+        job.finished = true;
+        completed++;
+    }
+
+    while (finishedPrefix < jobs.size() && jobs[finishedPrefix].finished) finishedPrefix++;
+
+    if (done()) {
+        totalMs = millisecondsSince(startTime);
+        for (auto& worker : workers) worker.join();
+        workers.clear();
+    }
+}
+
+float AssetLoader::progress() const {
+    return jobs.empty() ? 1.f : static_cast<float>(completed) / jobs.size();
+}
+
+void AssetLoader::logTimings(std::ostream& out) const {
+    std::vector<const Job*> sorted;
+    for (const Job& job : jobs) sorted.push_back(&job);
+    std::sort(sorted.begin(), sorted.end(), [](const Job* a, const Job* b) { return a->decodeMs > b->decodeMs; });
+
+    float decodeSum = 0.f, uploadSum = 0.f;
+    out << std::fixed << std::setprecision(2);
+    for (const Job* job : sorted) {
+        decodeSum += job->decodeMs;
+        uploadSum += job->uploadMs;
+        out << std::left << std::setw(8) << kindName(job->kind) << std::right
+            << " decode " << std::setw(7) << job->decodeMs << " ms  upload " << std::setw(6) << job->uploadMs
+            << " ms  " << job->path << (job->ok ? "" : " (failed)") << "\n";
+    }
+    out << jobs.size() << " assets in " << totalMs << " ms wall (" << decodeSum << " ms decode on "
+        << threadsUsed << " threads, " << uploadSum << " ms upload)" << std::endl;
+}
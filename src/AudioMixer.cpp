@@ -0,0 +1,155 @@
+#include "AudioMixer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+AudioMixer::AudioMixer() {
+    setCategoryLimit(Category::Explosion, 6);
+    setCategoryLimit(Category::Weapon, 2);
+    setCategoryLimit(Category::Pickup, 3);
+    setCategoryLimit(Category::Powerup, 2);
+}
+
+AudioMixer::SoundId AudioMixer::addSound(ResourceHandle<sf::SoundBuffer> buffer, Category category, float priority,
+                                         float volume) {
+    if (soundCount == maxSounds) {
+        std::cerr << "AudioMixer: all " << maxSounds << " sound slots are taken" << std::endl;
+        return invalidSound;
+    }
+    SoundId id = static_cast<SoundId>(soundCount++);
+    Sound& sound = sounds[id];
+    sound.buffer = std::move(buffer);
+    sound.category = category;
+    sound.priority = priority;
+    sound.volume = volume;
+    sound.duration = std::max(sound.buffer->getDuration().asSeconds(), 0.001f);
+
+    // sf::Sound needs a buffer to exist, so the pool is built on the first sound
+    if (!voices[0].sound) {
+        for (auto& voice : voices) voice.sound.emplace(*sound.buffer);
+    }
+    return id;
+}
+
+void AudioMixer::setCategoryLimit(Category category, std::size_t count) {
+    categoryLimits[static_cast<std::size_t>(category)] = std::min(count, voiceCount);
+}
+
+void AudioMixer::play(SoundId sound, sf::Vector2f position) {
+    if (sound >= soundCount) return; // Also drops invalidSound
+    sf::Vector2f d = position - listener;
+    float ratio = std::sqrt(d.x * d.x + d.y * d.y) / falloffDistance;
+    float gain = 1.f / (1.f + ratio * ratio);
+
+    Pending& p = pending[sound];
+    p.count++;
+    p.gain = std::max(p.gain, gain);
+}
+
+float AudioMixer::audibility(const Voice& voice) const {
+    const Sound& sound = sounds[voice.id];
+    float remaining = 1.f - (now - voice.startTime) / sound.duration;
+    return sound.priority * voice.gain * std::max(remaining, 0.f);
+}
+
+// A voice for a new trigger of the given score, or nullptr if every
+// candidate is more audible than it
+AudioMixer::Voice* AudioMixer::allocate(Category category, float score) {
+    std::size_t inCategory = 0;
+    Voice* categoryVictim = nullptr;
+    Voice* victim = nullptr;
+    Voice* freeVoice = nullptr;
+    for (auto& voice : voices) {
+        if (!voice.active) {
+            if (!freeVoice) freeVoice = &voice;
+            continue;
+        }
+        if (!victim || audibility(voice) < audibility(*victim)) victim = &voice;
+        if (sounds[voice.id].category == category) {
+            inCategory++;
+            if (!categoryVictim || audibility(voice) < audibility(*categoryVictim)) categoryVictim = &voice;
+        }
+    }
+
+    if (inCategory >= categoryLimits[static_cast<std::size_t>(category)]) victim = categoryVictim;
+    else if (freeVoice) return freeVoice;
+
+    if (!victim || audibility(*victim) > score) return nullptr;
+    victim->sound->stop();
+    victim->active = false;
+    stolenVoices++;
+    return victim;
+}
+
+void AudioMixer::start(Voice& voice, SoundId id, float gain) {
+    const Sound& sound = sounds[id];
+    voice.sound->setBuffer(*sound.buffer);
+    voice.sound->setVolume(std::min(sound.volume * gain, 100.f));
+    voice.sound->play();
+    voice.id = id;
+    voice.active = true;
+    voice.startTime = now;
+    voice.gain = gain;
+}
+
+void AudioMixer::update(float dt) {
+    now += dt;
+    for (auto& voice : voices) {
+        if (voice.active && voice.sound->getStatus() != sf::Sound::Status::Playing) voice.active = false;
+    }
+
+    // Most audible triggers get first pick of the voices
+    std::array<SoundId, maxSounds> order;
+    std::size_t triggered = 0;
+    for (std::size_t id = 0; id < soundCount; ++id) {
+        if (pending[id].count > 0) order[triggered++] = static_cast<SoundId>(id);
+    }
+    auto score = [&](SoundId id) { return sounds[id].priority * pending[id].gain; };
+    std::sort(order.begin(), order.begin() + triggered, [&](SoundId a, SoundId b) { return score(a) > score(b); });
+
+    for (std::size_t k = 0; k < triggered; ++k) {
+        SoundId id = order[k];
+        Pending p = pending[id];
+        pending[id] = {};
+
+        // A crowd of triggers plays once, a little louder: +15% per doubling
+        float gain = p.gain * std::min(1.f + 0.15f * std::log2(static_cast<float>(p.count)), 1.5f);
+
+        // Fold into the same sound if it only just started
+        Voice* recent = nullptr;
+        for (auto& voice : voices) {
+            if (voice.active && voice.id == id && now - voice.startTime < mergeWindow &&
+                (!recent || voice.startTime > recent->startTime)) {
+                recent = &voice;
+            }
+        }
+        if (recent) {
+            mergedTriggers += p.count;
+            if (gain > recent->gain) {
+                recent->gain = gain;
+                recent->sound->setVolume(std::min(sounds[id].volume * gain, 100.f));
+            }
+            continue;
+        }
+        mergedTriggers += p.count - 1;
+
+        Voice* voice = allocate(sounds[id].category, sounds[id].priority * gain);
+        if (!voice) {
+            droppedTriggers++;
+            continue;
+        }
+        start(*voice, id, gain);
+    }
+}
+
+void AudioMixer::stopAll() {
+    for (auto& voice : voices) {
+        if (voice.sound) voice.sound->stop();
+        voice.active = false;
+    }
+    pending = {};
+}
+
+std::size_t AudioMixer::activeVoices() const {
+    return static_cast<std::size_t>(std::count_if(voices.begin(), voices.end(), [](const Voice& v) { return v.active; }));
+}
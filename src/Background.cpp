@@ -1,66 +1,141 @@
 #include "Background.hpp"
+#include "Profiler.hpp"
+#include "ResourceCache.hpp"
 #include <iostream>
 #include <cmath>
 #include <algorithm>
 #include <cstdlib>
-#include <ctime>
+#include "Random.hpp"
+
+// Dust vertices sit on the dot centre and carry their corner offset
+// (+-0.5) in texCoords; the uniforms are the dot's scaled, rotated axes.
+static const char* dustVertexShader = R"(
+uniform vec2 stretchX;
+uniform vec2 stretchY;
+void main() {
+    vec2 offset = gl_MultiTexCoord0.x * stretchX + gl_MultiTexCoord0.y * stretchY;
+    gl_Position = gl_ModelViewProjectionMatrix * vec4(gl_Vertex.xy + offset, 0.0, 1.0);
+    gl_FrontColor = gl_Color;
+}
+)";
+
+// Appends a quad as two triangles; corners go clockwise from top-left
+static void appendQuad(std::vector<sf::Vertex>& out, const sf::Vector2f (&corners)[4],
+                       const sf::Vector2f (&texCoords)[4], sf::Color color) {
+    static constexpr int order[6] = {0, 1, 2, 0, 2, 3};
+    for (int i : order) {
+        out.push_back({corners[i], color, texCoords[i]});
+    }
+}
+
+static void regionCorners(const sf::IntRect& region, sf::Vector2f (&texCoords)[4]) {
+    float left = static_cast<float>(region.position.x);
+    float top = static_cast<float>(region.position.y);
+    float right = left + region.size.x;
+    float bottom = top + region.size.y;
+    texCoords[0] = {left, top};
+    texCoords[1] = {right, top};
+    texCoords[2] = {right, bottom};
+    texCoords[3] = {left, bottom};
+}
 
-Background::Background(const std::string& resourcePath) {
-    srand(time(nullptr));
-    seed = rand();
+Background::Background(const std::string& resourcePath, bool asyncGeneration, unsigned int seed)
+    : seed(seed), asyncGeneration(asyncGeneration) {
     loadTextures(resourcePath);
 
     // Initialize Layers
     // Layer 0: Deep Background (Stars) - Slowest
-    layers.push_back({0.05f, {}});
+    layers.emplace_back(0.05f);
     
     // Layer 1: Mid Background (Stars) - Medium speed
-    layers.push_back({0.1f, {}});
+    layers.emplace_back(0.1f);
 
     // Layer 2: Foreground (Planets) - Fastest (but still slower than camera)
-    layers.push_back({0.2f, {}});
+    layers.emplace_back(0.2f);
 
     // Layer 3: Dust/Speed Particles - Moves with camera (Parallax 1.0 or near)
-    layers.push_back({0.8f, {}});
-    
-    // Create 1x1 white texture
-    sf::Image whiteImg;
-    whiteImg.resize({1, 1}, sf::Color::White);
-    if (!whiteTexture.loadFromImage(whiteImg)) {
-        // Fallback?
+    layers.emplace_back(0.8f);
+
+    // Dust is stretched along the flight direction by one uniform for the
+    // whole layer. Without shaders the dots simply stay round.
+    if (sf::Shader::isAvailable()) {
+        dustShaderReady = dustShader.loadFromMemory(dustVertexShader, sf::Shader::Type::Vertex);
+    }
+
+    // Started last: the worker reads the atlas regions, seed and shader flag
+    if (asyncGeneration) {
+        worker = std::thread(&Background::workerLoop, this);
+    }
+}
+
+Background::~Background() {
+    if (worker.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(requestMutex);
+            stopping = true;
+        }
+        requestReady.notify_one();
+        worker.join();
+    }
+}
+
+void Background::workerLoop() {
+    while (true) {
+        ChunkRequest request;
+        {
+            std::unique_lock<std::mutex> lock(requestMutex);
+            requestReady.wait(lock, [&] { return stopping || !requests.empty(); });
+            if (stopping) return;
+            request = std::move(requests.front());
+            requests.pop_front();
+        }
+
+        std::unique_ptr<Chunk> chunk = generateChunk(request.cx, request.cy, request.layerIndex, std::move(request.storage));
+        // The main thread drains every frame, so a full queue clears quickly
+        while (!finished.push(chunk)) {
+            {
+                std::lock_guard<std::mutex> lock(requestMutex);
+                if (stopping) return;
+            }
+            std::this_thread::yield();
+        }
     }
 }
 
 void Background::loadTextures(const std::string& resourcePath) {
-    // Load Stars
+    // Stars and planets share one atlas so a layer is one draw call. The
+    // images are usually already decoded by the start-up loader.
+    ResourceCache& cache = ResourceCache::instance();
     for (int i = 1; i <= 5; ++i) {
-        sf::Texture tex;
-        std::string path = resourcePath + "/Stars/Star_" + std::to_string(i) + ".png";
-        if (tex.loadFromFile(path)) {
-            starTextures.push_back(std::move(tex));
-        } else {
-            std::cerr << "Failed to load: " << path << std::endl;
-        }
+        ResourceHandle<sf::Image> image = cache.image(resourcePath + "/Stars/Star_" + std::to_string(i) + ".png");
+        if (image.loaded()) starRegions.push_back(atlas.add(*image));
     }
 
-    // Load Planets
     for (int i = 1; i <= 9; i++) {
-        sf::Texture tex;
-        std::string path = resourcePath + "/Planets/Planet_" + std::to_string(i) + ".png";
-        if (tex.loadFromFile(path)) {
-            planetTextures.push_back(std::move(tex));
-        } else {
-            std::cerr << "Failed to load: " << path << std::endl;
-        }
+        ResourceHandle<sf::Image> image = cache.image(resourcePath + "/Planets/Planet_" + std::to_string(i) + ".png");
+        if (image.loaded()) planetRegions.push_back(atlas.add(*image));
+    }
+
+    if (!atlas.build()) {
+        starRegions.clear();
+        planetRegions.clear();
     }
 }
 
-void Background::update(const sf::Vector2f& cameraPos, const sf::Vector2f& viewSize) {
+static int chunkIndex(float v, int chunkSize) {
+    return static_cast<int>(std::floor(v / chunkSize));
+}
+
+void Background::update(const sf::Vector2f& cameraPos, const sf::Vector2f& viewSize, sf::Vector2f cameraVelocity) {
+    collectFinishedChunks();
+
     for (int i = 0; i < layers.size(); ++i) {
         sf::Vector2f virtualPos = cameraPos * layers[i].parallaxFactor;
-        
-        int cx = static_cast<int>(std::floor(virtualPos.x / chunkSize));
-        int cy = static_cast<int>(std::floor(virtualPos.y / chunkSize));
+        sf::Vector2i center(chunkIndex(virtualPos.x, chunkSize), chunkIndex(virtualPos.y, chunkSize));
+
+        // Where the camera will be if it keeps going, in this layer's space
+        sf::Vector2f aheadPos = virtualPos + cameraVelocity * (prefetchTicks * layers[i].parallaxFactor);
+        sf::Vector2i ahead(chunkIndex(aheadPos.x, chunkSize), chunkIndex(aheadPos.y, chunkSize));
 
         // Calculate radius based on view size (scaled by parallax factor? No, view size is constant)
         // But since we move slower, we might need to cover same area. 
@@ -71,135 +146,242 @@ void Background::update(const sf::Vector2f& cameraPos, const sf::Vector2f& viewS
         int radiusY = static_cast<int>(std::ceil(viewSize.y / chunkSize)) / 2 + 2;
         int radius = std::max(radiusX, radiusY);
 
-        // Generate new chunks
-        for (int x = cx - radius; x <= cx + radius; x++) {
-            for (int y = cy - radius; y <= cy + radius; y++) {
-                if (!layers[i].chunks.contains({x, y})) {
-                    generateChunk(x, y, i);
+        if (asyncGeneration) {
+            // Anything actually on screen can't wait for the worker
+            int left = chunkIndex(virtualPos.x - viewSize.x / 2.f, chunkSize);
+            int right = chunkIndex(virtualPos.x + viewSize.x / 2.f, chunkSize);
+            int top = chunkIndex(virtualPos.y - viewSize.y / 2.f, chunkSize);
+            int bottom = chunkIndex(virtualPos.y + viewSize.y / 2.f, chunkSize);
+            for (int x = left; x <= right; x++) {
+                for (int y = top; y <= bottom; y++) {
+                    std::unique_ptr<Chunk>* slot = layers[i].chunks.find(x, y);
+                    if (!slot || !*slot) {
+                        insertChunk(generateChunk(x, y, i, takeChunk()));
+                        syncChunkCount++;
+                    }
+                }
+            }
+
+            requestChunks(i, center, radius);
+            if (ahead != center) requestChunks(i, ahead, radius);
+        } else {
+            // Generate new chunks
+            for (int x = center.x - radius; x <= center.x + radius; x++) {
+                for (int y = center.y - radius; y <= center.y + radius; y++) {
+                    if (!layers[i].chunks.contains(x, y)) {
+                        insertChunk(generateChunk(x, y, i, takeChunk()));
+                    }
                 }
             }
         }
 
         // Remove old chunks
-        removeFarChunks(cx, cy, radius + 1, i);
+        removeFarChunks(center, ahead, radius + 1, i);
+    }
+
+    if (!newRequests.empty()) {
+        {
+            std::lock_guard<std::mutex> lock(requestMutex);
+            requests.insert(requests.end(), std::make_move_iterator(newRequests.begin()),
+                            std::make_move_iterator(newRequests.end()));
+        }
+        requestReady.notify_one();
+        newRequests.clear();
     }
 }
 
-void Background::generateChunk(int cx, int cy, int layerIndex) {
-    auto chunk = std::make_unique<Chunk>();
-    chunk->gridPos = {cx, cy};
+void Background::requestChunks(int layerIndex, sf::Vector2i center, int radius) {
+    Layer& layer = layers[layerIndex];
+    std::size_t first = newRequests.size();
+    for (int x = center.x - radius; x <= center.x + radius; x++) {
+        for (int y = center.y - radius; y <= center.y + radius; y++) {
+            if (layer.chunks.contains(x, y)) continue;
+            layer.chunks.insert(x, y); // Null until the worker hands it back
+            newRequests.push_back({x, y, layerIndex, takeChunk()});
+        }
+    }
+    // Nearest first, so the ring closest to the view lands soonest
+    std::sort(newRequests.begin() + first, newRequests.end(), [&](const ChunkRequest& a, const ChunkRequest& b) {
+        int da = std::max(std::abs(a.cx - center.x), std::abs(a.cy - center.y));
+        int db = std::max(std::abs(b.cx - center.x), std::abs(b.cy - center.y));
+        return da < db;
+    });
+}
+
+void Background::collectFinishedChunks() {
+    std::unique_ptr<Chunk> chunk;
+    while (finished.pop(chunk)) {
+        insertChunk(std::move(chunk));
+    }
+}
+
+void Background::insertChunk(std::unique_ptr<Chunk> chunk) {
+    Layer& layer = layers[chunk->layerIndex];
+    std::unique_ptr<Chunk>& slot = layer.chunks.insert(chunk->gridPos.x, chunk->gridPos.y);
+    // Already built on this thread while the worker was busy with it
+    if (slot) {
+        recycleChunk(std::move(chunk));
+        return;
+    }
+    slot = std::move(chunk);
+    layer.dirty = true;
+}
+
+std::unique_ptr<Background::Chunk> Background::takeChunk() {
+    if (freeChunks.empty()) return std::make_unique<Chunk>();
+    std::unique_ptr<Chunk> chunk = std::move(freeChunks.back());
+    freeChunks.pop_back();
+    return chunk;
+}
 
-    // Deterministic seed based on chunk coordinates, layer, and game seed
-    std::seed_seq seq{cx, cy, layerIndex, static_cast<int>(seed)};
-    std::vector<unsigned> seeds(1);
-    seq.generate(seeds.begin(), seeds.end());
-    std::mt19937 rng(seeds[0]);
+void Background::recycleChunk(std::unique_ptr<Chunk> chunk) {
+    chunk->vertices.clear(); // Keeps its capacity for the next fill
+    freeChunks.push_back(std::move(chunk));
+}
 
-    std::uniform_int_distribution<int> posDist(0, chunkSize);
+std::unique_ptr<Background::Chunk> Background::generateChunk(int cx, int cy, int layerIndex, std::unique_ptr<Chunk> chunk) const {
+    PROFILE_SCOPE(ChunkGeneration);
+    chunk->vertices.clear();
+    chunk->gridPos = {cx, cy};
+    chunk->layerIndex = layerIndex;
+
+    // Deterministic seed based on chunk coordinates, layer, and game seed;
+    // hashed straight into a generator, so no per-chunk seeding work
+    Rng rng(hashSeed(static_cast<std::uint32_t>(cx), static_cast<std::uint32_t>(cy),
+                     static_cast<std::uint32_t>(layerIndex), seed));
+    sf::Vector2f corners[4];
+    sf::Vector2f texCoords[4];
     
     // --- Stars (Layers 0 and 1) ---
     if (layerIndex == 0 || layerIndex == 1) {
-        std::uniform_int_distribution<int> starCountDist(12, 15); // Split density across layers
-        int starCount = starCountDist(rng);
+        int starCount = rng.range(12, 15); // Split density across layers
 
-        if (!starTextures.empty()) {
+        if (!starRegions.empty()) {
+            chunk->vertices.reserve(starCount * 6);
             for (int i = 0; i < starCount; i++) {
-                const sf::Texture& tex = starTextures[rng() % starTextures.size()];
-                sf::Sprite star(tex);
+                sf::IntRect region = atlas.getRegion(starRegions[rng.below(static_cast<std::uint32_t>(starRegions.size()))]);
                 
-                float lx = static_cast<float>(posDist(rng));
-                float ly = static_cast<float>(posDist(rng));
+                float lx = static_cast<float>(rng.range(0, chunkSize));
+                float ly = static_cast<float>(rng.range(0, chunkSize));
                 float wx = cx * chunkSize + lx;
                 float wy = cy * chunkSize + ly;
 
-                star.setPosition({wx, wy});
-
                 // Scale variation based on layer (deeper = smaller)
                 float minScale = (layerIndex == 0) ? 0.1f : 0.2f;
                 float maxScale = (layerIndex == 0) ? 0.3f : 0.5f;
-                std::uniform_real_distribution<float> scaleDist(minScale, maxScale);
-                
-                float scale = scaleDist(rng);
-                star.setScale({scale, scale});
+                float scale = rng.uniform(minScale, maxScale);
+                float w = region.size.x * scale;
+                float h = region.size.y * scale;
 
                 // Color variation
-                std::uniform_int_distribution<int> alphaDist(150, 255);
-                std::uniform_int_distribution<int> colorTint(200, 255);
-                star.setColor(sf::Color(colorTint(rng), colorTint(rng), colorTint(rng), alphaDist(rng)));
-
-                chunk->sprites.push_back(star);
+                auto r = static_cast<std::uint8_t>(rng.range(200, 255));
+                auto g = static_cast<std::uint8_t>(rng.range(200, 255));
+                auto b = static_cast<std::uint8_t>(rng.range(200, 255));
+                sf::Color color(r, g, b, static_cast<std::uint8_t>(rng.range(150, 255)));
+
+                // Top-left anchored, like the old sprites
+                corners[0] = {wx, wy};
+                corners[1] = {wx + w, wy};
+                corners[2] = {wx + w, wy + h};
+                corners[3] = {wx, wy + h};
+                regionCorners(region, texCoords);
+                appendQuad(chunk->vertices, corners, texCoords, color);
             }
         }
     }
 
     // --- Planets (Layer 2) ---
     if (layerIndex == 2) {
-        if (!planetTextures.empty()) {
-            std::uniform_real_distribution<float> planetChance(0.0f, 1.0f);
-            if (planetChance(rng) < 0.5f) { // 50% chance
-                const sf::Texture& tex = planetTextures[rng() % planetTextures.size()];
-                sf::Sprite planet(tex);
-
-                planet.setOrigin({tex.getSize().x * 0.5f, tex.getSize().y * 0.5f});
+        if (!planetRegions.empty()) {
+            if (rng.chance(0.5f)) {
+                sf::IntRect region = atlas.getRegion(planetRegions[rng.below(static_cast<std::uint32_t>(planetRegions.size()))]);
+                sf::Vector2f halfSize(region.size.x * 0.5f, region.size.y * 0.5f);
 
-                float lx = static_cast<float>(posDist(rng));
-                float ly = static_cast<float>(posDist(rng));
+                float lx = static_cast<float>(rng.range(0, chunkSize));
+                float ly = static_cast<float>(rng.range(0, chunkSize));
                 float wx = cx * chunkSize + lx;
                 float wy = cy * chunkSize + ly;
 
-                planet.setPosition({wx, wy});
-
-                std::uniform_real_distribution<float> scaleDist(1.f, 1.5f);
-                float scale = scaleDist(rng);
-                planet.setScale({scale, scale});
-                
-                std::uniform_real_distribution<float> rotDist(0.f, 360.f);
-                planet.setRotation(sf::degrees(rotDist(rng)));
-
-                planet.setColor(sf::Color(220, 220, 220, 255));
-
-                chunk->sprites.push_back(planet);
+                float scale = rng.uniform(1.f, 1.5f);
+                float rotation = rng.uniform(0.f, 360.f);
+
+                // Centred, scaled and rotated like the old sprite transform
+                sf::Transform transform;
+                transform.translate({wx, wy}).rotate(sf::degrees(rotation)).scale({scale, scale});
+                corners[0] = transform.transformPoint({-halfSize.x, -halfSize.y});
+                corners[1] = transform.transformPoint({halfSize.x, -halfSize.y});
+                corners[2] = transform.transformPoint({halfSize.x, halfSize.y});
+                corners[3] = transform.transformPoint({-halfSize.x, halfSize.y});
+                regionCorners(region, texCoords);
+                appendQuad(chunk->vertices, corners, texCoords, sf::Color(220, 220, 220, 255));
             }
         }
     }
 
     // --- Dust (Layer 3) ---
     if (layerIndex == 3) {
-        std::uniform_int_distribution<int> dustCountDist(8, 12);
-        int dustCount = dustCountDist(rng);
+        int dustCount = rng.range(8, 12);
+        chunk->vertices.reserve(dustCount * 6);
+
+        // Unit square around the centre; the shader scales it
+        texCoords[0] = {-0.5f, -0.5f};
+        texCoords[1] = {0.5f, -0.5f};
+        texCoords[2] = {0.5f, 0.5f};
+        texCoords[3] = {-0.5f, 0.5f};
         
         for (int i = 0; i < dustCount; i++) {
-            sf::Sprite dust(whiteTexture);
-            
-            float lx = static_cast<float>(posDist(rng));
-            float ly = static_cast<float>(posDist(rng));
+            float lx = static_cast<float>(rng.range(0, chunkSize));
+            float ly = static_cast<float>(rng.range(0, chunkSize));
             float wx = cx * chunkSize + lx;
             float wy = cy * chunkSize + ly;
-
-            dust.setPosition({wx, wy});
-            dust.setOrigin({0.5f, 0.5f});
             
             // Random opacity
-            std::uniform_int_distribution<int> alphaDist(50, 150);
-            dust.setColor(sf::Color(255, 255, 255, alphaDist(rng)));
-            
-            // Tiny base scale
-            dust.setScale({2.f, 2.f}); // 2x2 pixel
+            sf::Color color(255, 255, 255, static_cast<std::uint8_t>(rng.range(50, 150)));
 
-            chunk->sprites.push_back(dust);
+            for (int c = 0; c < 4; ++c) {
+                corners[c] = {wx, wy};
+                // Without the shader, bake the plain 2x2 pixel dot
+                if (!dustShaderReady) corners[c] += texCoords[c] * 2.f;
+            }
+            appendQuad(chunk->vertices, corners, texCoords, color);
         }
     }
 
-    layers[layerIndex].chunks[{cx, cy}] = std::move(chunk);
+    return chunk;
+}
+
+void Background::removeFarChunks(sf::Vector2i center, sf::Vector2i ahead, int radius, int layerIndex) {
+    Layer& layer = layers[layerIndex];
+
+    // Prefetched chunks ahead of the camera are kept too. Entries still out
+    // on the worker stay so they aren't requested twice.
+    auto isFar = [&](sf::Vector2i c, int x, int y) {
+        return std::abs(x - c.x) > radius || std::abs(y - c.y) > radius;
+    };
+    farChunks.clear();
+    layer.chunks.forEach([&](int x, int y, std::unique_ptr<Chunk>& chunk) {
+        if (chunk && isFar(center, x, y) && isFar(ahead, x, y)) farChunks.push_back({x, y});
+    });
+
+    for (sf::Vector2i key : farChunks) {
+        recycleChunk(std::move(*layer.chunks.find(key.x, key.y)));
+        layer.chunks.erase(key.x, key.y);
+    }
+    if (!farChunks.empty()) layer.dirty = true;
 }
 
-void Background::removeFarChunks(int cx, int cy, int radius, int layerIndex) {
-    std::erase_if(layers[layerIndex].chunks, [&](const auto& item) {
-        auto& [key, chunk] = item;
-        int dx = std::abs(key.first - cx);
-        int dy = std::abs(key.second - cy);
-        return dx > radius || dy > radius;
+void Background::rebuildLayer(Layer& layer) {
+    layer.vertices.clear();
+    layer.chunks.forEach([&](int, int, const std::unique_ptr<Chunk>& chunk) {
+        if (chunk) layer.vertices.insert(layer.vertices.end(), chunk->vertices.begin(), chunk->vertices.end());
     });
+    layer.dirty = false;
+
+    if (!sf::VertexBuffer::isAvailable() || layer.vertices.empty()) return;
+    if (layer.buffer.getVertexCount() < layer.vertices.size() && !layer.buffer.create(layer.vertices.size())) return;
+    if (!layer.buffer.update(layer.vertices.data(), layer.vertices.size(), 0)) {
+        std::cerr << "Failed to upload background layer" << std::endl;
+    }
 }
 
 void Background::draw(sf::RenderWindow& window, sf::Vector2f playerVelocity) {
@@ -211,43 +393,45 @@ void Background::draw(sf::RenderWindow& window, sf::Vector2f playerVelocity) {
     float speedSq = dir.x*dir.x + dir.y*dir.y;
     float speed = std::sqrt(speedSq);
     
-    float stretchFactor = 1.f;
-    sf::Angle angle = sf::degrees(0.f);
+    // Dust dot axes: 2x2 pixels at rest
+    sf::Vector2f stretchX(2.f, 0.f);
+    sf::Vector2f stretchY(0.f, 2.f);
     
     // Stretch logic
     // Player speed is usually 0-12 pixels/frame
     if (speed > 0.5f) {
-        stretchFactor = speed * 1.5f; 
+        float stretchFactor = speed * 1.5f; 
         if (stretchFactor > 20.f) stretchFactor = 20.f; // Cap
-        angle = sf::degrees(std::atan2(dir.y, dir.x) * 180.f / 3.14159f);
+        sf::Vector2f along = dir / speed;
+        stretchX = along * (2.f + stretchFactor); // Stretch X, keep Y thin
+        stretchY = sf::Vector2f(-along.y, along.x) * 2.f;
     }
 
     for (int i = 0; i < layers.size(); ++i) {
+        Layer& layer = layers[i];
+        if (layer.dirty) rebuildLayer(layer);
+        if (layer.vertices.empty()) continue;
+
         sf::View layerView = originalView;
-        layerView.setCenter(center * layers[i].parallaxFactor);
+        layerView.setCenter(center * layer.parallaxFactor);
         window.setView(layerView);
 
-        for (const auto& [key, chunk] : layers[i].chunks) {
-            for (auto& sprite : chunk->sprites) { 
-                // Note: iterating by non-const reference to modify sprite for drawing (if we wanted to modify state persistently)
-                // But we shouldn't modify persistent state for temporary visual effect if we want them to return to dots.
-                // However, sprites are stateful. We must reset or modify them.
-                // Since this is immediate mode draw, we can modify -> draw -> reset, OR
-                // Just force the transform we want every frame.
-                
-                if (i == 3) { // Dust Layer
-                    // Apply trail effect
-                     if (speed > 0.5f) {
-                         sprite.setRotation(angle);
-                         sprite.setScale({2.f + stretchFactor, 2.f}); // Stretch X, keep Y thin
-                     } else {
-                         sprite.setRotation(sf::degrees(0.f));
-                         sprite.setScale({2.f, 2.f}); // Back to dot
-                     }
-                }
-                
-                window.draw(sprite);
+        sf::RenderStates states;
+        if (i == 3) { // Dust Layer
+            if (dustShaderReady) {
+                dustShader.setUniform("stretchX", stretchX);
+                dustShader.setUniform("stretchY", stretchY);
+                states.shader = &dustShader;
             }
+        } else {
+            states.texture = &atlas.getTexture();
+        }
+
+        std::size_t count = layer.vertices.size();
+        if (layer.buffer.getVertexCount() >= count) {
+            window.draw(layer.buffer, 0, count, states);
+        } else {
+            window.draw(layer.vertices.data(), count, sf::PrimitiveType::Triangles, states);
         }
     }
 
@@ -1,47 +1,71 @@
 #include "Enemy.hpp"
-#include "window.hpp"
-#include <random>
+#include "JobSystem.hpp"
 #include <cmath>
 #include <algorithm>
 
-static std::mt19937 rng(std::random_device{}());
-static std::uniform_int_distribution<int> randOffset(-100, 100);
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define ENEMY_SSE2 1
+#endif
 
-sf::Texture Enemy::textureInitial;
-sf::Texture Enemy::textureExplosion;
-bool Enemy::texturesLoaded = false;
+static std::size_t padToLanes(std::size_t n) {
+    return (n + EnemyPool::laneWidth - 1) / EnemyPool::laneWidth * EnemyPool::laneWidth;
+}
 
-void Enemy::loadTextures() {
-    if (!texturesLoaded) {
-        if (!textureInitial.loadFromFile("resources/enemy_Initial.png")) {
-            // Handle error or use fallback
-        }
-        if (!textureExplosion.loadFromFile("resources/Enemy_BeforeExplosion.png")) {
-            // Handle error
-        }
-        texturesLoaded = true;
-    }
+void EnemyPool::resizeArrays(std::size_t n) {
+    std::size_t padded = padToLanes(n);
+    if (padded <= posX.size()) return;
+    posX.resize(padded, 0.f);
+    posY.resize(padded, 0.f);
+    prevX.resize(padded, 0.f);
+    prevY.resize(padded, 0.f);
+    speed.resize(padded, 0.f);
+    hp.resize(padded, 0.f);
+    flags.resize(padded, 0);
+    serial.resize(padded, 0);
+    trails.resize(padded);
+}
+
+void EnemyPool::reserve(std::size_t n) {
+    std::size_t padded = padToLanes(n);
+    posX.reserve(padded);
+    posY.reserve(padded);
+    prevX.reserve(padded);
+    prevY.reserve(padded);
+    speed.reserve(padded);
+    hp.reserve(padded);
+    flags.reserve(padded);
+    serial.reserve(padded);
+    trails.reserve(padded);
+}
+
+void EnemyPool::clear() {
+    // Zero the live lanes so padding stays inert when the pool regrows
+    std::fill(posX.begin(), posX.end(), 0.f);
+    std::fill(posY.begin(), posY.end(), 0.f);
+    std::fill(prevX.begin(), prevX.end(), 0.f);
+    std::fill(prevY.begin(), prevY.end(), 0.f);
+    std::fill(speed.begin(), speed.end(), 0.f);
+    std::fill(hp.begin(), hp.end(), 0.f);
+    std::fill(flags.begin(), flags.end(), 0);
+    trails.clearAll();
+    count = 0;
 }
 
-Enemy::Enemy(const Window &Game) : body(textureInitial) {
-    loadTextures();
-    // Scale sprite to match desired dimensions (assuming texture is roughly square or we want to stretch)
-    sf::Vector2u texSize = textureInitial.getSize();
-    body.setScale({width / texSize.x, height / texSize.y});
-    
-    body.setOrigin({texSize.x / 2.f, texSize.y / 2.f});
-    body.setColor(color);
-    HP = maxHp;
-    respawn(Game.worldView, 50.f);
+std::size_t EnemyPool::spawn(const sf::FloatRect &viewBounds, float difficulty) {
+    std::size_t i = count++;
+    resizeArrays(count);
+    respawn(i, viewBounds, difficulty);
+    return i;
 }
 
-void Enemy::respawn(const sf::View &view, float margin) {
-    std::uniform_real_distribution<float> choice(0.f, 1.f);
-    sf::Vector2f viewSize = view.getSize();
-    std::uniform_real_distribution<float> horizontal(0.f, viewSize.x + 2.f * margin);
-    std::uniform_real_distribution<float> vertical(0.f, viewSize.y + 2.f * margin);
+void EnemyPool::respawn(std::size_t i, const sf::FloatRect &viewBounds, float difficulty) {
+    float margin = spawnMargin;
+    sf::Vector2f viewSize = viewBounds.size;
 
-    sf::Vector2f viewCenter = view.getCenter();
+    sf::Vector2f viewCenter = viewBounds.position + viewSize / 2.f;
     float left = viewCenter.x - viewSize.x / 2.f - margin;
     float top = viewCenter.y - viewSize.y / 2.f - margin;
     float right = viewCenter.x + viewSize.x / 2.f + margin;
@@ -49,23 +73,196 @@ void Enemy::respawn(const sf::View &view, float margin) {
 
     sf::Vector2f spawnPos = viewCenter;
 
-    if (choice(rng) < 0.5f)
+    if (rng.chance(0.5f))
     {
-        spawnPos.x = (choice(rng) < 0.5f) ? left : right;
-        spawnPos.y = top + vertical(rng);
+        spawnPos.x = rng.chance(0.5f) ? left : right;
+        spawnPos.y = top + rng.uniform(0.f, viewSize.y + 2.f * margin);
     }
     else
     {
-        spawnPos.y = (choice(rng) < 0.5f) ? top : bottom;
-        spawnPos.x = left + horizontal(rng);
+        spawnPos.y = rng.chance(0.5f) ? top : bottom;
+        spawnPos.x = left + rng.uniform(0.f, viewSize.x + 2.f * margin);
+    }
+
+    posX[i] = prevX[i] = spawnPos.x;
+    posY[i] = prevY[i] = spawnPos.y;
+    speed[i] = baseSpeed * std::clamp(difficulty, 0.5f, 5.f);
+    hp[i] = maxHp;
+    flags[i] = 0;
+    serial[i] = nextSerial++;
+    trails.clear(i);
+}
+
+void EnemyPool::snapshot() {
+    std::copy(posX.begin(), posX.begin() + count, prevX.begin());
+    std::copy(posY.begin(), posY.begin() + count, prevY.begin());
+}
+
+void EnemyPool::updateTrails(float dt) {
+    JobSystem::instance().parallelFor(count, jobGrain, [&](std::size_t begin, std::size_t end, std::size_t) {
+        trails.update(posX.data(), posY.data(), begin, end, dt);
+    });
+}
+
+// Scalar reference for one lane; the SIMD paths below compute exactly the
+// same expressions in the same order.
+static std::uint8_t classifyLane(float x, float y, float hp, float px, float py, float vx, float vy,
+                                 bool playerMoving, const sf::FloatRect &view) {
+    float dx = px - x;
+    float dy = py - y;
+    std::uint8_t f = 0;
+    if (hp <= 0.f) f |= EnemyPool::Dead;
+    bool onScreen = x >= view.position.x && x <= view.position.x + view.size.x &&
+                    y >= view.position.y && y <= view.position.y + view.size.y;
+    // Player velocity dotted with player->enemy; negative means we're flying away
+    float dot = vx * -dx + vy * -dy;
+    if (!onScreen && playerMoving && dot < 0.f) f |= EnemyPool::Recycle;
+    return f;
+}
+
+void EnemyPool::classify(sf::Vector2f playerPos, sf::Vector2f playerVel, const sf::FloatRect &viewBounds) {
+    JobSystem::instance().parallelFor(count, jobGrain, [&](std::size_t begin, std::size_t end, std::size_t) {
+        classifyRange(begin, end, playerPos, playerVel, viewBounds);
+    });
+}
+
+// Vector loops may run past end into padding, but never into the next
+// chunk: every chunk but the last ends on a multiple of jobGrain
+void EnemyPool::classifyRange(std::size_t begin, std::size_t end, sf::Vector2f playerPos, sf::Vector2f playerVel,
+                              const sf::FloatRect &viewBounds) {
+    bool playerMoving = playerVel.x * playerVel.x + playerVel.y * playerVel.y > 16.f;
+    std::size_t i = begin;
+
+#if defined(__AVX__)
+    const __m256 px = _mm256_set1_ps(playerPos.x), py = _mm256_set1_ps(playerPos.y);
+    const __m256 vx = _mm256_set1_ps(playerVel.x), vy = _mm256_set1_ps(playerVel.y);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 left = _mm256_set1_ps(viewBounds.position.x);
+    const __m256 right = _mm256_set1_ps(viewBounds.position.x + viewBounds.size.x);
+    const __m256 top = _mm256_set1_ps(viewBounds.position.y);
+    const __m256 bottom = _mm256_set1_ps(viewBounds.position.y + viewBounds.size.y);
+    const int movingMask = playerMoving ? 0xFF : 0;
+    for (; i < end; i += 8) {
+        __m256 x = _mm256_loadu_ps(&posX[i]);
+        __m256 y = _mm256_loadu_ps(&posY[i]);
+        __m256 dx = _mm256_sub_ps(px, x);
+        __m256 dy = _mm256_sub_ps(py, y);
+        int deadBits = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(&hp[i]), zero, _CMP_LE_OQ));
+        __m256 inside = _mm256_and_ps(_mm256_and_ps(_mm256_cmp_ps(x, left, _CMP_GE_OQ), _mm256_cmp_ps(x, right, _CMP_LE_OQ)),
+                                      _mm256_and_ps(_mm256_cmp_ps(y, top, _CMP_GE_OQ), _mm256_cmp_ps(y, bottom, _CMP_LE_OQ)));
+        __m256 dot = _mm256_add_ps(_mm256_mul_ps(vx, _mm256_sub_ps(zero, dx)), _mm256_mul_ps(vy, _mm256_sub_ps(zero, dy)));
+        int awayBits = _mm256_movemask_ps(_mm256_cmp_ps(dot, zero, _CMP_LT_OQ));
+        int recycleBits = ~_mm256_movemask_ps(inside) & awayBits & movingMask;
+        for (int lane = 0; lane < 8; ++lane) {
+            flags[i + lane] = static_cast<std::uint8_t>(((deadBits >> lane) & 1) * Dead |
+                                                        ((recycleBits >> lane) & 1) * Recycle);
+        }
+    }
+#elif defined(ENEMY_SSE2)
+    const __m128 px = _mm_set1_ps(playerPos.x), py = _mm_set1_ps(playerPos.y);
+    const __m128 vx = _mm_set1_ps(playerVel.x), vy = _mm_set1_ps(playerVel.y);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 left = _mm_set1_ps(viewBounds.position.x);
+    const __m128 right = _mm_set1_ps(viewBounds.position.x + viewBounds.size.x);
+    const __m128 top = _mm_set1_ps(viewBounds.position.y);
+    const __m128 bottom = _mm_set1_ps(viewBounds.position.y + viewBounds.size.y);
+    const int movingMask = playerMoving ? 0xF : 0;
+    for (; i < end; i += 4) {
+        __m128 x = _mm_loadu_ps(&posX[i]);
+        __m128 y = _mm_loadu_ps(&posY[i]);
+        __m128 dx = _mm_sub_ps(px, x);
+        __m128 dy = _mm_sub_ps(py, y);
+        int deadBits = _mm_movemask_ps(_mm_cmple_ps(_mm_loadu_ps(&hp[i]), zero));
+        __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(x, left), _mm_cmple_ps(x, right)),
+                                   _mm_and_ps(_mm_cmpge_ps(y, top), _mm_cmple_ps(y, bottom)));
+        __m128 dot = _mm_add_ps(_mm_mul_ps(vx, _mm_sub_ps(zero, dx)), _mm_mul_ps(vy, _mm_sub_ps(zero, dy)));
+        int awayBits = _mm_movemask_ps(_mm_cmplt_ps(dot, zero));
+        int recycleBits = ~_mm_movemask_ps(inside) & awayBits & movingMask;
+        for (int lane = 0; lane < 4; ++lane) {
+            flags[i + lane] = static_cast<std::uint8_t>(((deadBits >> lane) & 1) * Dead |
+                                                        ((recycleBits >> lane) & 1) * Recycle);
+        }
     }
+#endif
 
-    body.setPosition(spawnPos);
-    trail.clear();
-    HP = maxHp;
+    for (; i < end; ++i) {
+        flags[i] = classifyLane(posX[i], posY[i], hp[i], playerPos.x, playerPos.y,
+                                playerVel.x, playerVel.y, playerMoving, viewBounds);
+    }
 }
 
-void Enemy::applyDifficulty(float difficulty){
-    float clamped = std::clamp(difficulty, 0.5f, 5.f);
-    speed = baseSpeed * clamped;
+void EnemyPool::buildGrid(SpatialHash &grid) const {
+    grid.clear();
+    grid.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        grid.insert(static_cast<std::uint32_t>(i), {posX[i], posY[i]});
+    }
+    grid.build();
+}
+
+void EnemyPool::markNearPlayer(const SpatialHash &grid, sf::Vector2f playerPos) {
+    grid.forEachInRadius(playerPos, warningRadius, [&](std::uint32_t i) {
+        float dx = playerPos.x - posX[i];
+        float dy = playerPos.y - posY[i];
+        float distSq = dx * dx + dy * dy;
+        if (distSq < warningRadius * warningRadius) flags[i] |= NearPlayer;
+        if (distSq < explodeRadius * explodeRadius) flags[i] |= Explode;
+    });
+}
+
+void EnemyPool::seek(sf::Vector2f target, float dt) {
+    JobSystem::instance().parallelFor(count, jobGrain, [&](std::size_t begin, std::size_t end, std::size_t) {
+        seekRange(begin, end, target, dt);
+    });
+}
+
+void EnemyPool::seekRange(std::size_t begin, std::size_t end, sf::Vector2f target, float dt) {
+    std::size_t i = begin;
+
+#if defined(__AVX__)
+    const __m256 tx = _mm256_set1_ps(target.x), ty = _mm256_set1_ps(target.y);
+    const __m256 vdt = _mm256_set1_ps(dt);
+    const __m256 minLen = _mm256_set1_ps(0.0001f);
+    for (; i < end; i += 8) {
+        __m256 x = _mm256_loadu_ps(&posX[i]);
+        __m256 y = _mm256_loadu_ps(&posY[i]);
+        __m256 dx = _mm256_sub_ps(tx, x);
+        __m256 dy = _mm256_sub_ps(ty, y);
+        __m256 len = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)));
+        __m256 moving = _mm256_cmp_ps(len, minLen, _CMP_GT_OQ);
+        __m256 step = _mm256_mul_ps(_mm256_loadu_ps(&speed[i]), vdt);
+        __m256 mx = _mm256_and_ps(moving, _mm256_mul_ps(_mm256_div_ps(dx, len), step));
+        __m256 my = _mm256_and_ps(moving, _mm256_mul_ps(_mm256_div_ps(dy, len), step));
+        _mm256_storeu_ps(&posX[i], _mm256_add_ps(x, mx));
+        _mm256_storeu_ps(&posY[i], _mm256_add_ps(y, my));
+    }
+#elif defined(ENEMY_SSE2)
+    const __m128 tx = _mm_set1_ps(target.x), ty = _mm_set1_ps(target.y);
+    const __m128 vdt = _mm_set1_ps(dt);
+    const __m128 minLen = _mm_set1_ps(0.0001f);
+    for (; i < end; i += 4) {
+        __m128 x = _mm_loadu_ps(&posX[i]);
+        __m128 y = _mm_loadu_ps(&posY[i]);
+        __m128 dx = _mm_sub_ps(tx, x);
+        __m128 dy = _mm_sub_ps(ty, y);
+        __m128 len = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)));
+        __m128 moving = _mm_cmpgt_ps(len, minLen);
+        __m128 step = _mm_mul_ps(_mm_loadu_ps(&speed[i]), vdt);
+        __m128 mx = _mm_and_ps(moving, _mm_mul_ps(_mm_div_ps(dx, len), step));
+        __m128 my = _mm_and_ps(moving, _mm_mul_ps(_mm_div_ps(dy, len), step));
+        _mm_storeu_ps(&posX[i], _mm_add_ps(x, mx));
+        _mm_storeu_ps(&posY[i], _mm_add_ps(y, my));
+    }
+#endif
+
+    for (; i < end; ++i) {
+        float dx = target.x - posX[i];
+        float dy = target.y - posY[i];
+        float len = std::sqrt(dx * dx + dy * dy);
+        if (len > 0.0001f) {
+            float step = speed[i] * dt;
+            posX[i] += (dx / len) * step;
+            posY[i] += (dy / len) * step;
+        }
+    }
 }
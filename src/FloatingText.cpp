@@ -0,0 +1,87 @@
+#include "FloatingText.hpp"
+#include "Profiler.hpp"
+#include <algorithm>
+#include <charconv>
+#include <iostream>
+
+FloatingTextPool::FloatingTextPool(const sf::Font& font)
+    : atlas(font, characterSize, 1.f), popups(capacity),
+      vertices(capacity * GlyphAtlas::maxVertices(maxLength)),
+      buffer(sf::PrimitiveType::Triangles, sf::VertexBuffer::Usage::Stream) {
+    if (sf::VertexBuffer::isAvailable() && !buffer.create(vertices.size())) {
+        std::cerr << "Failed to create floating text vertex buffer" << std::endl;
+    }
+}
+
+void FloatingTextPool::spawn(std::string_view str, sf::Vector2f position, sf::Color color, float duration,
+                             float scale) {
+    std::size_t slot = liveCount;
+    if (liveCount == capacity) {
+        // Replace whichever popup is closest to fading out
+        slot = 0;
+        for (std::size_t i = 1; i < liveCount; ++i) {
+            if (popups[i].lifetime < popups[slot].lifetime) slot = i;
+        }
+    } else {
+        liveCount++;
+    }
+
+    Popup& p = popups[slot];
+    p.length = static_cast<std::uint8_t>(std::min(str.size(), maxLength));
+    std::copy_n(str.data(), p.length, p.text);
+    p.width = atlas.measure({p.text, p.length});
+    p.position = position;
+    p.color = color;
+    p.lifetime = p.maxLifetime = duration;
+    p.scale = scale;
+
+    // Random slight horizontal drift, upward movement
+    p.velocity = {rng.uniform(-30.f, 30.f), -50.f};
+}
+
+void FloatingTextPool::spawnNumber(int value, sf::Vector2f position, sf::Color color, float duration, float scale) {
+    char digits[maxLength];
+    auto result = std::to_chars(digits, digits + maxLength, value);
+    spawn({digits, static_cast<std::size_t>(result.ptr - digits)}, position, color, duration, scale);
+}
+
+void FloatingTextPool::update(float dt) {
+    // Swap-and-pop; the swapped-in popup is checked on the same index
+    std::size_t i = 0;
+    while (i < liveCount) {
+        Popup& p = popups[i];
+        p.lifetime -= dt;
+        if (p.lifetime > 0.f) {
+            p.position += p.velocity * dt;
+            ++i;
+            continue;
+        }
+        p = popups[--liveCount];
+    }
+}
+
+void FloatingTextPool::draw(sf::RenderTarget& target) {
+    PROFILE_SCOPE(DrawText);
+    if (liveCount == 0) return;
+
+    sf::Vertex* v = vertices.data();
+    float halfHeight = characterSize / 2.f;
+    for (std::size_t i = 0; i < liveCount; ++i) {
+        const Popup& p = popups[i];
+        auto alpha = static_cast<std::uint8_t>(std::clamp(p.lifetime / p.maxLifetime, 0.f, 1.f) * 255.f);
+        sf::Color fill = p.color;
+        fill.a = static_cast<std::uint8_t>(fill.a * alpha / 255);
+        sf::Color outline(0, 0, 0, alpha);
+        sf::Vector2f topLeft = p.position - sf::Vector2f(p.width / 2.f, halfHeight) * p.scale;
+        v += atlas.build(v, {p.text, p.length}, topLeft, p.scale, fill, outline);
+    }
+
+    std::size_t vertexCount = static_cast<std::size_t>(v - vertices.data());
+    sf::RenderStates states;
+    states.texture = &atlas.texture();
+    if (buffer.getVertexCount() >= vertexCount && buffer.update(vertices.data(), vertexCount, 0)) {
+        target.draw(buffer, 0, vertexCount, states);
+    } else {
+        target.draw(vertices.data(), vertexCount, sf::PrimitiveType::Triangles, states);
+    }
+}
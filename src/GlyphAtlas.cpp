@@ -0,0 +1,85 @@
+#include "GlyphAtlas.hpp"
+
+GlyphAtlas::GlyphAtlas(const sf::Font& font, unsigned characterSize, float outlineThickness)
+    : font(font), characterSize(characterSize), hasOutline(outlineThickness > 0.f) {
+    // Same one-pixel padding sf::Text puts around each glyph quad
+    constexpr float padding = 1.f;
+    auto bake = [&](char c, float thickness) {
+        const sf::Glyph& g = font.getGlyph(static_cast<char32_t>(c), characterSize, false, thickness);
+        Glyph out;
+        out.advance = g.advance;
+        out.bounds = {{g.bounds.position.x - padding, g.bounds.position.y - padding},
+                      {g.bounds.size.x + 2.f * padding, g.bounds.size.y + 2.f * padding}};
+        out.texRect = {{static_cast<float>(g.textureRect.position.x) - padding,
+                        static_cast<float>(g.textureRect.position.y) - padding},
+                       {static_cast<float>(g.textureRect.size.x) + 2.f * padding,
+                        static_cast<float>(g.textureRect.size.y) + 2.f * padding}};
+        return out;
+    };
+
+    for (std::size_t i = 0; i < glyphCount; ++i) {
+        char c = static_cast<char>(firstChar + i);
+        fill[i] = bake(c, 0.f);
+        outline[i] = hasOutline ? bake(c, outlineThickness) : fill[i];
+    }
+    for (std::size_t a = 0; a < glyphCount; ++a) {
+        for (std::size_t b = 0; b < glyphCount; ++b) {
+            kerning[a * glyphCount + b] = font.getKerning(static_cast<char32_t>(firstChar + a),
+                                                          static_cast<char32_t>(firstChar + b), characterSize);
+        }
+    }
+}
+
+float GlyphAtlas::measure(std::string_view str) const {
+    float x = 0.f;
+    std::size_t previous = glyphCount;
+    for (char c : str) {
+        std::size_t i = index(c);
+        if (previous != glyphCount) x += kerning[previous * glyphCount + i];
+        x += fill[i].advance;
+        previous = i;
+    }
+    return x;
+}
+
+std::size_t GlyphAtlas::addQuads(sf::Vertex* out, std::string_view str, sf::Vector2f origin, float scale,
+                                 const std::array<Glyph, glyphCount>& glyphs, sf::Color color) const {
+    sf::Vertex* v = out;
+    float x = 0.f;
+    float baseline = static_cast<float>(characterSize);
+    std::size_t previous = glyphCount;
+    for (char c : str) {
+        std::size_t i = index(c);
+        if (previous != glyphCount) x += kerning[previous * glyphCount + i];
+        previous = i;
+
+        const Glyph& g = glyphs[i];
+        if (c != ' ') {
+            float left = origin.x + (x + g.bounds.position.x) * scale;
+            float top = origin.y + (baseline + g.bounds.position.y) * scale;
+            float right = left + g.bounds.size.x * scale;
+            float bottom = top + g.bounds.size.y * scale;
+            float u1 = g.texRect.position.x, v1 = g.texRect.position.y;
+            float u2 = u1 + g.texRect.size.x, v2 = v1 + g.texRect.size.y;
+
+            v[0] = {{left, top}, color, {u1, v1}};
+            v[1] = {{right, top}, color, {u2, v1}};
+            v[2] = {{left, bottom}, color, {u1, v2}};
+            v[3] = {{left, bottom}, color, {u1, v2}};
+            v[4] = {{right, top}, color, {u2, v1}};
+            v[5] = {{right, bottom}, color, {u2, v2}};
+            v += 6;
+        }
+        // Advance by the fill glyph so outline and fill line up
+        x += fill[i].advance;
+    }
+    return static_cast<std::size_t>(v - out);
+}
+
+std::size_t GlyphAtlas::build(sf::Vertex* out, std::string_view str, sf::Vector2f origin, float scale,
+                              sf::Color fillColor, sf::Color outlineColor) const {
+    std::size_t count = 0;
+    if (hasOutline) count += addQuads(out, str, origin, scale, outline, outlineColor);
+    count += addQuads(out + count, str, origin, scale, fill, fillColor);
+    return count;
+}
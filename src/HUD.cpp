@@ -1,185 +1,231 @@
 #include "HUD.hpp"
+#include <algorithm>
+#include <charconv>
 #include <cmath>
 #include <iostream>
-#include <iomanip>
-#include <sstream>
+
+namespace {
+
+// Texel inside the 2x2 white square at the corner of a font page
+const sf::Vector2f whiteTexel(1.f, 1.f);
+
+const sf::Color pipLit = sf::Color::Blue;
+const sf::Color pipUnlit(50, 50, 50, 150);
+
+} // namespace
 
 HUD::HUD(const sf::Font& font, const sf::Vector2f& windowSize)
-    : font(font), windowSize(windowSize), coinText(font)
+    : digits(font, counterSize, 1.f), windowSize(windowSize),
+      buffer(sf::PrimitiveType::Triangles, sf::VertexBuffer::Usage::Dynamic)
 {
-    // HUD Layout: Bottom Left
-    // Padding from bottom edges
+    // HUD Layout: Bottom Left, stacked upwards from the bottom margin:
+    // Dash (Bottom), Energy (Middle), Health (Top)
     float bottomMargin = 30.f;
-    float barHeight = 20.f;
     float gap = 10.f;
 
-    // --- Health Bar ---
-    // Positioned at the top of the stack
-    // Y = Height - margin - (3 bars heights) - (2 gaps)
-    // Actually, let's stack them upwards from bottom.
-    // Dash (Bottom), Energy (Middle), Health (Top)
-    
-    // Dash Bar (Bottom)
+    // Dash Bar (Bottom), purple
     sf::Vector2f dashSize(150.f, 10.f);
     sf::Vector2f dashPos(20.f, windowSize.y - bottomMargin - dashSize.y);
-    // Color: Purple
-    initBar(dashBar, dashPos, dashSize, sf::Color(162,25,255));
+    dashGauge = addGauge(dashPos, dashSize, sf::Color(162,25,255));
 
     // Energy Bar (Middle)
     sf::Vector2f enSize(200.f, 15.f);
     sf::Vector2f enPos(20.f, dashPos.y - gap - enSize.y);
-    initBar(energyBar, enPos, enSize, sf::Color::Yellow);
+    energyGauge = addGauge(enPos, enSize, sf::Color::Yellow);
 
     // Health Bar (Top)
     sf::Vector2f hpSize(200.f, 20.f);
     sf::Vector2f hpPos(20.f, enPos.y - gap - hpSize.y);
-    initBar(healthBar, hpPos, hpSize, sf::Color::Red);
+    healthGauge = addGauge(hpPos, hpSize, sf::Color::Red);
 
     // --- Shockwave Charges ---
-    // Positioned above the Health Bar, Left Aligned
+    // Above the Health Bar, left aligned with it
     float circleRadius = 10.f;
     for (int i = 0; i < 3; ++i) {
-        sf::CircleShape circle(circleRadius);
-        sf::Vector2f origin(circleRadius, circleRadius);
-        circle.setOrigin(origin);
-        
-        // Start X should be same as hpPos.x (20.f) + radius
-        // Y should be hpPos.y - padding - radius
-        // Let's verify hpPos.y is calculated above: 
-        // sf::Vector2f hpPos(20.f, enPos.y - gap - hpSize.y);
-        
-        // Let's use hpPos.x + radius + i * (diameter + gap)
-        float startX = hpPos.x + circleRadius;
-        float startY = hpPos.y - 20.f; // 15px above health bar
-
-        sf::Vector2f pos(startX + i * 25.f, startY);
-        circle.setPosition(pos); 
-        
-        // Color: Gray by default, Active will be Blue
-        circle.setFillColor(sf::Color(100, 100, 100, 150));
-        circle.setOutlineColor(sf::Color::White);
-        circle.setOutlineThickness(2.f);
-        shockwaveCircles.push_back(circle);
+        sf::Vector2f center(hpPos.x + circleRadius + i * 25.f, hpPos.y - 20.f);
+        pips.push_back({addCircle(center, circleRadius, pipUnlit), false});
+        addRing(center, circleRadius, 2.f, sf::Color::White);
     }
 
     // --- Coins ---
+    // Shared with the world coins (Coin3) through the cache
     for (int i = 1; i <= 8; ++i) {
-        sf::Texture tex;
-        if (tex.loadFromFile("resources/Coin/Coin" + std::to_string(i) + ".png")) {
+        ResourceHandle<sf::Texture> tex = ResourceCache::instance().texture("resources/Coin/Coin" + std::to_string(i) + ".png");
+        if (tex.loaded()) {
             coinTextures.push_back(tex);
         }
     }
 
+    // Coins stay top right
+    sf::Vector2f coinPos(windowSize.x - 40.f, 30.f);
     if (!coinTextures.empty()) {
-        coinSprite.emplace(coinTextures[0]);
-        sf::Vector2f scale(1.2f, 1.2f);
-        coinSprite->setScale(scale);
-        
+        coinSprite.emplace(*coinTextures[0]);
+        coinSprite->setScale({1.2f, 1.2f});
         sf::FloatRect bounds = coinSprite->getLocalBounds();
-        sf::Vector2f origin(bounds.size.x / 2.f, bounds.size.y / 2.f);
-        coinSprite->setOrigin(origin);
+        coinSprite->setOrigin({bounds.size.x / 2.f, bounds.size.y / 2.f});
+        coinSprite->setPosition(coinPos);
     }
 
-    coinText.setCharacterSize(32);
-    coinText.setFillColor(sf::Color::White);
-    coinText.setOutlineColor(sf::Color::Black);
-    coinText.setOutlineThickness(1.f);
-    coinText.setString("0");
-    
-    // Position Coin Top Right (Keep this as is?)
-    // User only said "GUI position to bottom left", likely referring to the bars.
-    // Coins generally stay top right or top left. I'll keep top right unless requested.
-    sf::Vector2f coinPos(windowSize.x - 40.f, 30.f);
-    if(coinSprite) coinSprite->setPosition(coinPos);
+    // Room for the longest number; unused glyph slots stay degenerate
+    counterAnchor = {coinPos.x - 35.f, coinPos.y - 5.f};
+    counterFirst = vertices.size();
+    vertices.resize(vertices.size() + GlyphAtlas::maxVertices(maxDigits));
+    setCoins(0);
 }
 
-void HUD::initBar(HUD::Bar& bar, const sf::Vector2f& position, const sf::Vector2f& size, const sf::Color& fillColor) {
-    bar.background.setPosition(position);
-    bar.background.setSize(size);
-    bar.background.setFillColor(sf::Color::Black);
-    bar.background.setOutlineColor(sf::Color::White);
-    bar.background.setOutlineThickness(2.f);
+std::size_t HUD::addRect(const sf::FloatRect& rect, const sf::Color& color) {
+    std::size_t first = vertices.size();
+    vertices.resize(first + 6);
+    setRect(first, rect, color);
+    return first;
+}
+
+void HUD::setRect(std::size_t first, const sf::FloatRect& rect, const sf::Color& color) {
+    float left = rect.position.x, top = rect.position.y;
+    float right = left + rect.size.x, bottom = top + rect.size.y;
+    sf::Vertex* v = &vertices[first];
+    v[0].position = {left, top};
+    v[1].position = {right, top};
+    v[2].position = {left, bottom};
+    v[3].position = {left, bottom};
+    v[4].position = {right, top};
+    v[5].position = {right, bottom};
+    for (int i = 0; i < 6; ++i) {
+        v[i].color = color;
+        v[i].texCoords = whiteTexel;
+    }
+    dirty = true;
+}
 
-    bar.foreground.setPosition(position);
-    bar.foreground.setSize(size); 
-    bar.foreground.setFillColor(fillColor);
+std::size_t HUD::addCircle(const sf::Vector2f& center, float radius, const sf::Color& color) {
+    std::size_t first = vertices.size();
+    auto point = [&](unsigned i) {
+        float angle = static_cast<float>(i) * 2.f * 3.14159265f / circlePoints - 3.14159265f / 2.f;
+        return center + sf::Vector2f(std::cos(angle), std::sin(angle)) * radius;
+    };
+    for (unsigned i = 0; i < circlePoints; ++i) {
+        vertices.push_back({center, color, whiteTexel});
+        vertices.push_back({point(i), color, whiteTexel});
+        vertices.push_back({point(i + 1), color, whiteTexel});
+    }
+    dirty = true;
+    return first;
+}
+
+void HUD::addRing(const sf::Vector2f& center, float radius, float thickness, const sf::Color& color) {
+    auto point = [&](unsigned i, float r) {
+        float angle = static_cast<float>(i) * 2.f * 3.14159265f / circlePoints - 3.14159265f / 2.f;
+        return center + sf::Vector2f(std::cos(angle), std::sin(angle)) * r;
+    };
+    float outer = radius + thickness;
+    for (unsigned i = 0; i < circlePoints; ++i) {
+        sf::Vector2f a = point(i, radius), b = point(i + 1, radius);
+        sf::Vector2f c = point(i, outer), d = point(i + 1, outer);
+        for (sf::Vector2f p : {a, b, c, c, b, d}) vertices.push_back({p, color, whiteTexel});
+    }
+    dirty = true;
 }
 
-void HUD::updateBar(HUD::Bar& bar, float percentage, const sf::Color& baseColor) {
-    percentage = std::clamp(percentage, 0.f, 1.f);
-    sf::Vector2f fullSize = bar.background.getSize();
-    sf::Vector2f newSize(fullSize.x * percentage, fullSize.y);
-    bar.foreground.setSize(newSize);
-    bar.foreground.setFillColor(baseColor);
+std::size_t HUD::addGauge(const sf::Vector2f& position, const sf::Vector2f& size, const sf::Color& color) {
+    // Black background with a 2px white frame outside it, like the old
+    // outlined RectangleShape, then the fill on top
+    const float frame = 2.f;
+    addRect({position, size}, sf::Color::Black);
+    addRect({{position.x - frame, position.y - frame}, {size.x + 2.f * frame, frame}}, sf::Color::White);
+    addRect({{position.x - frame, position.y + size.y}, {size.x + 2.f * frame, frame}}, sf::Color::White);
+    addRect({{position.x - frame, position.y}, {frame, size.y}}, sf::Color::White);
+    addRect({{position.x + size.x, position.y}, {frame, size.y}}, sf::Color::White);
+
+    Gauge gauge{addRect({position, size}, color), position, size, size.x, color};
+    gauges.push_back(gauge);
+    return gauges.size() - 1;
+}
+
+void HUD::setGauge(std::size_t id, float fraction, const sf::Color& color) {
+    Gauge& gauge = gauges[id];
+    // Whole pixels, so a slowly recharging bar only patches when it grows
+    float width = std::round(std::clamp(fraction, 0.f, 1.f) * gauge.size.x);
+    if (width == gauge.width && color == gauge.color) return;
+    gauge.width = width;
+    gauge.color = color;
+    setRect(gauge.first, {gauge.position, {width, gauge.size.y}}, color);
+}
+
+void HUD::setPip(std::size_t i, bool lit) {
+    Pip& pip = pips[i];
+    if (pip.lit == lit) return;
+    pip.lit = lit;
+    sf::Color color = lit ? pipLit : pipUnlit;
+    for (std::size_t v = 0; v < circlePoints * 3; ++v) vertices[pip.first + v].color = color;
+    dirty = true;
+}
+
+void HUD::setCoins(int coins) {
+    if (coins == shownCoins) return;
+    shownCoins = coins;
+
+    char text[maxDigits];
+    auto result = std::to_chars(text, text + maxDigits, coins);
+    std::string_view str(text, static_cast<std::size_t>(result.ptr - text));
+
+    // Right-aligned on the anchor, digits centred on it vertically
+    sf::FloatRect ink = digits.glyphBounds('0');
+    float baseline = static_cast<float>(digits.size());
+    sf::Vector2f topLeft(counterAnchor.x - digits.measure(str),
+                         counterAnchor.y - ink.size.y / 2.f - (baseline + ink.position.y));
+    sf::Vertex* slots = &vertices[counterFirst];
+    std::size_t used = digits.build(slots, str, topLeft, 1.f, sf::Color::White, sf::Color::Black);
+    std::fill(slots + used, slots + GlyphAtlas::maxVertices(maxDigits), sf::Vertex{});
+    dirty = true;
 }
 
 void HUD::update(const Player& player, int coins, float dt) {
-    // Update Health
+    // Health: green, then orange below half, red below a quarter
     float hpPercent = player.getHealthPercent();
     sf::Color hpColor = sf::Color::Red;
     if (hpPercent > 0.5f) hpColor = sf::Color::Green;
-    else if (hpPercent > 0.25f) hpColor = sf::Color(255, 165, 0); 
+    else if (hpPercent > 0.25f) hpColor = sf::Color(255, 165, 0);
+    setGauge(healthGauge, hpPercent, hpColor);
 
-    updateBar(healthBar, hpPercent, hpColor);
+    // Energy goes red while overheated
+    sf::Color energyColor = player.isOverheated ? sf::Color(255, 50, 50) : sf::Color::Yellow;
+    setGauge(energyGauge, player.getLaserEnergyPercent(), energyColor);
 
-    // Update Energy
-    float energyPercent = player.getLaserEnergyPercent();
-    sf::Color energyColor = sf::Color::Yellow;
-    if (player.isOverheated) energyColor = sf::Color(255, 50, 50); 
-    updateBar(energyBar, energyPercent, energyColor);
+    setGauge(dashGauge, player.getNitroPercent(), sf::Color(162,25,255));
 
-    // Update Dash
-    float nitroPercent = player.getNitroPercent();
-    float dashReady = nitroPercent; 
-    // Dash Bar Color: Purple
-    updateBar(dashBar, dashReady, sf::Color(162,25,255));
-
-    // Update Shockwave Charges
-    for (int i = 0; i < 3; ++i) {
-        if (i < player.shockwaveCharges) {
-            // Active Color: Blue
-            shockwaveCircles[i].setFillColor(sf::Color::Blue);
-        } else {
-            shockwaveCircles[i].setFillColor(sf::Color(50, 50, 50, 150));
-        }
+    for (std::size_t i = 0; i < pips.size(); ++i) {
+        setPip(i, static_cast<int>(i) < player.shockwaveCharges);
     }
 
-    // Update Coin Logic
+    setCoins(coins);
+
+    // Coin icon animation
     if (!coinTextures.empty() && coinSprite) {
         coinAnimTimer += dt;
         if (coinAnimTimer >= 0.1f) {
             coinAnimTimer = 0.f;
             currentCoinFrame = (currentCoinFrame + 1) % coinTextures.size();
-            coinSprite->setTexture(coinTextures[currentCoinFrame]);
+            coinSprite->setTexture(*coinTextures[currentCoinFrame]);
         }
     }
-    
-    coinText.setString(std::to_string(coins));
-    sf::FloatRect textBounds = coinText.getLocalBounds();
-    sf::Vector2f textOrigin(textBounds.size.x, textBounds.size.y / 2.f);
-    coinText.setOrigin(textOrigin); 
-    
-    if(coinSprite) {
-        sf::Vector2f iconPos = coinSprite->getPosition();
-        sf::Vector2f textPos(iconPos.x - 35.f, iconPos.y - 5.f);
-        coinText.setPosition(textPos); 
-    }
 }
 
 void HUD::draw(sf::RenderWindow& window) {
-    window.draw(healthBar.background);
-    window.draw(healthBar.foreground);
-
-    window.draw(energyBar.background);
-    window.draw(energyBar.foreground);
-    
-    window.draw(dashBar.background);
-    window.draw(dashBar.foreground);
+    sf::RenderStates states;
+    states.texture = &digits.texture();
 
-    for (const auto& circle : shockwaveCircles) {
-        window.draw(circle);
+    if (dirty && sf::VertexBuffer::isAvailable()) {
+        if (buffer.getVertexCount() < vertices.size() && !buffer.create(vertices.size())) {
+            std::cerr << "Failed to create HUD vertex buffer" << std::endl;
+        }
+        if (buffer.getVertexCount() >= vertices.size()) dirty = !buffer.update(vertices.data());
+    }
+    if (!dirty && buffer.getVertexCount() >= vertices.size()) {
+        window.draw(buffer, 0, vertices.size(), states);
+    } else {
+        // No VBO support; draw the same vertices client-side
+        window.draw(vertices.data(), vertices.size(), sf::PrimitiveType::Triangles, states);
     }
-    
-    if(coinSprite) window.draw(*coinSprite);
-    window.draw(coinText);
+
+    if (coinSprite) window.draw(*coinSprite);
 }
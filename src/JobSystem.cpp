@@ -0,0 +1,121 @@
+#include "JobSystem.hpp"
+#include <cstdlib>
+
+JobSystem& JobSystem::instance() {
+    static JobSystem jobs;
+    return jobs;
+}
+
+JobSystem::JobSystem() {
+    // LSS_THREADS counts the caller too, so LSS_THREADS=1 is single-threaded
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    if (const char* env = std::getenv("LSS_THREADS")) {
+        threads = static_cast<unsigned>(std::max(1, std::atoi(env)));
+    }
+    setWorkerCount(std::min(threads - 1, 15u));
+}
+
+JobSystem::~JobSystem() {
+    stopWorkers();
+}
+
+void JobSystem::setWorkerCount(unsigned count) {
+    stopWorkers();
+    queues.clear();
+    for (unsigned i = 0; i <= count; ++i) queues.push_back(std::make_unique<Queue>());
+    for (unsigned i = 0; i < count; ++i) workers.emplace_back(&JobSystem::workerLoop, this, i);
+}
+
+void JobSystem::stopWorkers() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& worker : workers) worker.join();
+    workers.clear();
+    stopping = false;
+}
+
+void JobSystem::run(Task& task, std::size_t chunks) {
+    task.remaining.store(chunks, std::memory_order_relaxed);
+
+    // Contiguous runs of chunks per queue, so neighbouring ranges start out
+    // on the same thread; stealing evens out whatever is left
+    std::size_t queueCount = queues.size();
+    for (std::size_t q = 0; q < queueCount; ++q) {
+        std::size_t first = q * chunks / queueCount;
+        std::size_t last = (q + 1) * chunks / queueCount;
+        if (first == last) continue;
+        std::lock_guard<std::mutex> lock(queues[q]->mutex);
+        for (std::size_t c = first; c < last; ++c) queues[q]->jobs.push_back({&task, c});
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        generation++;
+    }
+    wake.notify_all();
+
+    // The caller works through its own share, then steals
+    std::size_t self = queueCount - 1;
+    while (task.remaining.load(std::memory_order_acquire) > 0) {
+        Job job;
+        if (popOrSteal(self, job)) execute(job);
+        else std::this_thread::yield();
+    }
+}
+
+void JobSystem::execute(const Job& job) {
+    Task* task = job.task;
+    std::size_t begin = job.chunk * task->grain;
+    std::size_t end = std::min(task->count, begin + task->grain);
+    task->invoke(task->context, begin, end, job.chunk);
+    // Last touch of the task: the caller may return as soon as this hits 0
+    task->remaining.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+bool JobSystem::popOrSteal(std::size_t self, Job& job) {
+    {
+        Queue& own = *queues[self];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.jobs.empty()) {
+            job = own.jobs.back();
+            own.jobs.pop_back();
+            return true;
+        }
+    }
+    std::size_t queueCount = queues.size();
+    for (std::size_t k = 1; k < queueCount; ++k) {
+        Queue& victim = *queues[(self + k) % queueCount];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.jobs.empty()) {
+            job = victim.jobs.front();
+            victim.jobs.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void JobSystem::workerLoop(std::size_t self) {
+    std::uint64_t seen = 0;
+    while (true) {
+        Job job;
+        bool found = popOrSteal(self, job);
+        // Passes come in quick succession within a tick, so spin briefly
+        // before going to sleep
+        for (int spin = 0; !found && spin < 64; ++spin) {
+            std::this_thread::yield();
+            found = popOrSteal(self, job);
+        }
+        if (found) {
+            execute(job);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wake.wait(lock, [&] { return stopping || generation != seen; });
+        if (stopping) return;
+        seen = generation;
+    }
+}
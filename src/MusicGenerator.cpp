@@ -0,0 +1,214 @@
+#include "MusicGenerator.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr float twoPi = 6.28318530718f;
+constexpr int loopBeats = 16; // 4 bars of 4/4
+constexpr float baseBpm = 130.f;
+constexpr int kickLength = 12000; // Samples
+
+const float bassNotes[] = {55.f, 55.f, 65.41f, 73.42f, 49.f, 55.f, 65.41f, 82.41f};
+
+const float chordFreqs[4][3] = {
+    {220.0f, 260.63f, 320.63f}, // Am
+    {174.61f, 220.0f, 260.63f}, // F
+    {196.0f, 246.94f, 320.63f}, // G
+    {220.0f, 260.63f, 320.63f}  // Am resolve
+};
+
+// Per-sample multipliers for exp(-t * rate) envelopes
+const float kickAmpDecay = std::exp(-12.f / MusicGenerator::sampleRate);
+const float kickSweepDecay = std::exp(-25.f / MusicGenerator::sampleRate);
+const float kickClickDecay = std::exp(-100.f / MusicGenerator::sampleRate);
+const float bassDuckDecay = std::exp(-15.f / MusicGenerator::sampleRate);
+const float padDuckDecay = std::exp(-10.f / MusicGenerator::sampleRate);
+
+// phase is in cycles, [0, 1)
+float lookup(const std::array<float, MusicGenerator::tableSize + 1>& table, float phase) {
+    float index = phase * MusicGenerator::tableSize;
+    int i = static_cast<int>(index);
+    float frac = index - i;
+    return table[i] + (table[i + 1] - table[i]) * frac;
+}
+
+// Into [0, 1). For a tiny negative phase, phase - floor(phase) rounds to
+// exactly 1, which would index one past the end of the table.
+float wrap(float phase) {
+    phase -= std::floor(phase);
+    return phase >= 1.f ? phase - 1.f : phase;
+}
+
+void advance(float& phase, float increment) {
+    phase = wrap(phase + increment);
+}
+
+} // namespace
+
+MusicGenerator::MusicGenerator() {
+    // Tables are the only set-up work: two 2K-sample cycles
+    for (std::size_t i = 0; i <= tableSize; ++i) {
+        float x = twoPi * static_cast<float>(i) / tableSize;
+        sineTable[i] = std::sin(x);
+        float saw = 0.f;
+        for (int k = 1; k <= 6; ++k) saw += std::sin(x * k) / k;
+        sawTable[i] = saw;
+    }
+
+    reset();
+    initialize(1, sampleRate, {sf::SoundChannel::Mono});
+}
+
+MusicGenerator::~MusicGenerator() {
+    // The stream thread calls back into us; stop it before members go away
+    stop();
+}
+
+void MusicGenerator::setDifficulty(float d) {
+    difficulty.store(d, std::memory_order_relaxed);
+}
+
+void MusicGenerator::reset() {
+    beat = 0.0;
+    lastSixteenth = -1;
+    seconds = 0.0;
+    kick = {};
+    bass = {};
+    hat = {};
+    padPhase = {};
+    bassDuck = padDuck = 0.f;
+    noiseState = 999;
+}
+
+void MusicGenerator::onSeek(sf::Time timeOffset) {
+    reset();
+    // Approximate: assumes the base tempo for the skipped span
+    beat = std::fmod(timeOffset.asSeconds() * baseBpm / 60.0, static_cast<double>(loopBeats));
+    seconds = timeOffset.asSeconds();
+}
+
+const std::int16_t* MusicGenerator::render() {
+    renderBlock();
+    return block.data();
+}
+
+bool MusicGenerator::onGetData(Chunk& data) {
+    renderBlock();
+    data.samples = block.data();
+    data.sampleCount = block.size();
+    return true; // Endless
+}
+
+float MusicGenerator::noise() {
+    // xorshift32, mapped to [-1, 1)
+    noiseState ^= noiseState << 13;
+    noiseState ^= noiseState >> 17;
+    noiseState ^= noiseState << 5;
+    return static_cast<float>(noiseState) * (2.f / 4294967296.f) - 1.f;
+}
+
+void MusicGenerator::trigger(int sixteenth, float bpm, float intensity) {
+    float beatSeconds = 60.f / bpm;
+
+    if (sixteenth % 4 == 0) {
+        kick.remaining = kickLength;
+        kick.phase = 0.f;
+        kick.sweep = 1.f;
+        kick.amp = 1.f + 0.2f * intensity;
+        kick.click = 0.4f;
+        bassDuck = 1.f;
+        padDuck = 1.f;
+    }
+
+    if (sixteenth % 2 == 0) {
+        int step = sixteenth / 2;
+        float stepSeconds = beatSeconds / 2.f;
+        bass.remaining = static_cast<int>(stepSeconds * 0.7f * sampleRate);
+        bass.freq = bassNotes[step % 8];
+        bass.env = 1.f;
+        bass.envStep = 1.f / bass.remaining;
+    }
+
+    // The third 16th of each beat is left open for groove until things heat up
+    if (sixteenth % 4 != 2 || intensity > 0.35f) {
+        hat.remaining = static_cast<int>(0.03f * sampleRate);
+        hat.last = 0.f;
+        hat.env = 1.f;
+        hat.envStep = 1.f / hat.remaining;
+    }
+}
+
+void MusicGenerator::renderBlock() {
+    // Difficulty 1..5 pushes the tempo from 130 to 150 bpm and thickens the mix
+    float intensity = std::clamp((difficulty.load(std::memory_order_relaxed) - 1.f) / 4.f, 0.f, 1.f);
+    float bpm = baseBpm + 20.f * intensity;
+    double beatsPerSample = bpm / 60.0 / sampleRate;
+    float bassGain = 0.18f * 1.2f * (1.f + 0.3f * intensity);
+
+    // The pad's LFOs move far slower than a block, so they're sampled once
+    float t = static_cast<float>(seconds);
+    float padWobble = 0.3f * std::sin(t * 0.3f) / twoPi; // In cycles
+    float padGain = 0.03f * (0.4f + 0.6f * std::sin(t * 0.5f));
+
+    for (std::size_t i = 0; i < blockSize; ++i) {
+        int sixteenth = static_cast<int>(beat * 4.0);
+        if (sixteenth != lastSixteenth) {
+            lastSixteenth = sixteenth;
+            trigger(sixteenth, bpm, intensity);
+        }
+
+        float mix = 0.f;
+
+        if (kick.remaining > 0) {
+            float freq = 55.f + 250.f * kick.sweep;
+            mix += lookup(sineTable, kick.phase) * kick.amp * 0.8f + kick.click;
+            advance(kick.phase, freq / sampleRate);
+            kick.sweep *= kickSweepDecay;
+            kick.amp *= kickAmpDecay;
+            kick.click *= kickClickDecay;
+            kick.remaining--;
+        }
+
+        if (bass.remaining > 0) {
+            mix += lookup(sawTable, bass.phase) * bassGain * bass.env * (1.f - bassDuck);
+            advance(bass.phase, bass.freq / sampleRate);
+            bass.env -= bass.envStep;
+            bass.remaining--;
+        }
+
+        if (hat.remaining > 0) {
+            float white = noise() * 0.2f;
+            float hp = white - hat.last * 0.7f; // simple HP filter
+            hat.last = white;
+            mix += hp * hat.env;
+            hat.env -= hat.envStep;
+            hat.remaining--;
+        }
+
+        const float* chord = chordFreqs[sixteenth / 16];
+        float pad = 0.f;
+        for (int v = 0; v < 3; ++v) {
+            pad += lookup(sineTable, wrap(padPhase[v] + padWobble));
+            advance(padPhase[v], chord[v] / sampleRate);
+        }
+        mix += pad * padGain * (1.f - padDuck);
+
+        bassDuck *= bassDuckDecay;
+        padDuck *= padDuckDecay;
+
+        bus[i] = mix;
+
+        beat += beatsPerSample;
+        if (beat >= loopBeats) {
+            beat -= loopBeats;
+            lastSixteenth = -1;
+        }
+    }
+    seconds += static_cast<double>(blockSize) / sampleRate;
+
+    // Single conversion from the float bus
+    for (std::size_t i = 0; i < blockSize; ++i) {
+        block[i] = static_cast<std::int16_t>(std::clamp(bus[i], -1.f, 1.f) * 32767.f);
+    }
+}
@@ -0,0 +1,154 @@
+#include "Profiler.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+
+namespace {
+
+const char* zoneNames[profileZoneCount] = {
+    "Input",
+    "Simulation",
+    "Spawn",
+    "Particles",
+    "Laser",
+    "Pickups",
+    "Enemies",
+    "ChunkGeneration",
+    "BackgroundUpdate",
+    "HudUpdate",
+    "DrawBackground",
+    "DrawEntities",
+    "DrawParticles",
+    "DrawText",
+    "DrawHud",
+    "Present",
+};
+
+std::uint8_t threadIndex() {
+    static std::atomic<std::uint8_t> nextIndex{0};
+    thread_local std::uint8_t index = nextIndex.fetch_add(1, std::memory_order_relaxed);
+    return index;
+}
+
+} // namespace
+
+const char* profileZoneName(ProfileZone zone) {
+    return zone == ProfileZone::Count ? "Frame" : zoneNames[static_cast<std::size_t>(zone)];
+}
+
+Profiler& Profiler::instance() {
+    static Profiler profiler;
+    return profiler;
+}
+
+Profiler::Profiler()
+    : origin(Clock::now()), frameStart(origin), frames(frameCapacity), events(eventCapacity) {
+    for (auto& ns : zoneNs) ns.store(0, std::memory_order_relaxed);
+}
+
+void Profiler::record(ProfileZone zone, Clock::time_point start, Clock::time_point end) {
+    if (!enabled.load(std::memory_order_relaxed)) return;
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    std::size_t z = static_cast<std::size_t>(zone);
+    zoneNs[z].fetch_add(static_cast<std::uint64_t>(ns), std::memory_order_relaxed);
+
+    std::size_t slot = eventsWritten.fetch_add(1, std::memory_order_relaxed) % eventCapacity;
+    Event& e = events[slot];
+    // The first scope can start before the profiler itself is constructed
+    e.startNs = start > origin ? static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(start - origin).count()) : 0;
+    e.durationNs = static_cast<std::uint32_t>(std::min<long long>(ns, 0xFFFFFFFFll));
+    e.zone = static_cast<std::uint8_t>(z);
+    e.thread = threadIndex();
+}
+
+void Profiler::endFrame() {
+    Clock::time_point now = Clock::now();
+    std::size_t index = framesWritten.load(std::memory_order_relaxed);
+
+    FrameSample& sample = frames[index % frameCapacity];
+    sample.frame = index;
+    sample.frameMs = std::chrono::duration<float, std::milli>(now - frameStart).count();
+    for (std::size_t z = 0; z < profileZoneCount; ++z) {
+        sample.zoneMs[z] = zoneNs[z].exchange(0, std::memory_order_relaxed) * 1e-6f;
+    }
+    frameStart = now;
+
+    framesWritten.store(index + 1, std::memory_order_release);
+}
+
+void Profiler::copyFrames(std::vector<FrameSample>& out, std::size_t count) const {
+    std::size_t written = framesWritten.load(std::memory_order_acquire);
+    count = std::min({count, written, frameCapacity});
+    out.clear();
+    out.reserve(count);
+    for (std::size_t i = written - count; i < written; ++i) {
+        out.push_back(frames[i % frameCapacity]);
+    }
+}
+
+Profiler::Stats Profiler::stats(ProfileZone zone, std::size_t frameWindow) const {
+    std::size_t written = framesWritten.load(std::memory_order_acquire);
+    std::size_t count = std::min({frameWindow, written, frameCapacity});
+    Stats result;
+    if (count == 0) return result;
+
+    // Reused between calls; the overlay asks for every zone each refresh
+    thread_local std::vector<float> values;
+    values.clear();
+    for (std::size_t i = written - count; i < written; ++i) {
+        const FrameSample& sample = frames[i % frameCapacity];
+        values.push_back(zone == ProfileZone::Count ? sample.frameMs : sample.zoneMs[static_cast<std::size_t>(zone)]);
+    }
+
+    double sum = 0.0;
+    result.min = values[0];
+    for (float v : values) {
+        sum += v;
+        result.min = std::min(result.min, v);
+    }
+    result.avg = static_cast<float>(sum / count);
+
+    std::size_t p99Index = std::min(count - 1, static_cast<std::size_t>(count * 0.99));
+    std::nth_element(values.begin(), values.begin() + p99Index, values.end());
+    result.p99 = values[p99Index];
+    return result;
+}
+
+bool Profiler::writeCsv(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file) return false;
+
+    file << "frame,frame_ms";
+    for (std::size_t z = 0; z < profileZoneCount; ++z) file << ',' << zoneNames[z] << "_ms";
+    file << '\n';
+
+    std::vector<FrameSample> samples;
+    copyFrames(samples, frameCapacity);
+    for (const FrameSample& sample : samples) {
+        file << sample.frame << ',' << sample.frameMs;
+        for (float ms : sample.zoneMs) file << ',' << ms;
+        file << '\n';
+    }
+    return static_cast<bool>(file);
+}
+
+bool Profiler::writeChromeTrace(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file) return false;
+
+    // Trace Event Format, complete ("X") events in microseconds;
+    // open it in chrome://tracing or ui.perfetto.dev
+    std::size_t written = eventsWritten.load(std::memory_order_acquire);
+    std::size_t count = std::min(written, eventCapacity);
+    file << std::fixed << std::setprecision(3) << "{\"traceEvents\":[\n";
+    bool first = true;
+    for (std::size_t i = written - count; i < written; ++i) {
+        const Event& e = events[i % eventCapacity];
+        if (!first) file << ",\n";
+        first = false;
+        file << "{\"name\":\"" << zoneNames[e.zone] << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << int(e.thread)
+             << ",\"ts\":" << e.startNs / 1000.0 << ",\"dur\":" << e.durationNs / 1000.0 << "}";
+    }
+    file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    return static_cast<bool>(file);
+}
@@ -0,0 +1,51 @@
+#include "ProfilerOverlay.hpp"
+#include <cstdio>
+#include <string>
+
+ProfilerOverlay::ProfilerOverlay(const sf::Font& font, const sf::Vector2f& windowSize)
+    : windowSize(windowSize), text(font, "", 16)
+{
+    panel.setFillColor(sf::Color(0, 0, 0, 170));
+    panel.setOutlineColor(sf::Color(255, 255, 255, 60));
+    panel.setOutlineThickness(1.f);
+    text.setFillColor(sf::Color(200, 255, 200));
+}
+
+void ProfilerOverlay::update(float dt) {
+    if (!visible) return;
+    refreshTimer += dt;
+    if (refreshTimer < refreshInterval) return;
+    refreshTimer = 0.f;
+    rebuild();
+}
+
+void ProfilerOverlay::rebuild() {
+    const Profiler& profiler = Profiler::instance();
+    char line[96];
+    std::snprintf(line, sizeof(line), "ms over last %zu frames (F3)\n", windowFrames);
+    std::string lines = line;
+
+    auto addLine = [&](ProfileZone zone) {
+        Profiler::Stats s = profiler.stats(zone, windowFrames);
+        std::snprintf(line, sizeof(line), "%-17s %6.2f %6.2f %6.2f\n", profileZoneName(zone), s.min, s.avg, s.p99);
+        lines += line;
+    };
+
+    std::snprintf(line, sizeof(line), "%-17s %6s %6s %6s\n", "", "min", "avg", "p99");
+    lines += line;
+    addLine(ProfileZone::Count);
+    for (std::size_t z = 0; z < profileZoneCount; ++z) addLine(static_cast<ProfileZone>(z));
+
+    text.setString(lines);
+    sf::FloatRect bounds = text.getLocalBounds();
+    float padding = 10.f;
+    panel.setSize({bounds.size.x + 2.f * padding, bounds.size.y + bounds.position.y + 2.f * padding});
+    panel.setPosition({windowSize.x - panel.getSize().x - 20.f, 20.f});
+    text.setPosition(panel.getPosition() + sf::Vector2f(padding, padding));
+}
+
+void ProfilerOverlay::draw(sf::RenderWindow& window) const {
+    if (!visible) return;
+    window.draw(panel);
+    window.draw(text);
+}
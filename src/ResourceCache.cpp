@@ -0,0 +1,169 @@
+#include "ResourceCache.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+bool loadResource(sf::Texture& texture, const std::string& path) { return texture.loadFromFile(path); }
+bool loadResource(sf::Image& image, const std::string& path) { return image.loadFromFile(path); }
+bool loadResource(sf::SoundBuffer& buffer, const std::string& path) { return buffer.loadFromFile(path); }
+bool loadResource(sf::Font& font, const std::string& path) { return font.openFromFile(path); }
+
+std::size_t residentSize(const sf::Texture& texture, const std::string&) {
+    sf::Vector2u size = texture.getSize();
+    return static_cast<std::size_t>(size.x) * size.y * 4; // RGBA8 on the GPU
+}
+
+std::size_t residentSize(const sf::Image& image, const std::string&) {
+    sf::Vector2u size = image.getSize();
+    return static_cast<std::size_t>(size.x) * size.y * 4;
+}
+
+std::size_t residentSize(const sf::SoundBuffer& buffer, const std::string&) {
+    return static_cast<std::size_t>(buffer.getSampleCount()) * sizeof(std::int16_t);
+}
+
+std::size_t residentSize(const sf::Font&, const std::string& path) {
+    // Glyph pages grow with use; the face itself is the file
+    std::error_code error;
+    auto size = std::filesystem::file_size(path, error);
+    return error ? 0 : static_cast<std::size_t>(size);
+}
+
+} // namespace
+
+ResourceCache& ResourceCache::instance() {
+    static ResourceCache cache;
+    return cache;
+}
+
+// The file is read with the mutex released, so loader threads missing the
+// cache don't queue behind each other's disk I/O. Two threads can then load
+// the same path at once; the first to insert wins and the other copy is
+// dropped, so every caller still shares one entry.
+template <typename T>
+ResourceHandle<T> ResourceCache::acquire(Table<T>& table, const std::string& path) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = table.find(path);
+        if (it != table.end()) return ResourceHandle<T>(it->second);
+    }
+
+    auto entry = std::make_shared<typename ResourceHandle<T>::Entry>();
+    entry->path = path;
+    entry->loaded = loadResource(entry->resource, path);
+    if (entry->loaded) {
+        entry->bytes = residentSize(entry->resource, path);
+    } else {
+        std::cerr << "Failed to load " << path << std::endl;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto [it, inserted] = table.emplace(path, std::move(entry));
+    return ResourceHandle<T>(it->second);
+}
+
+template <typename T>
+bool ResourceCache::insert(Table<T>& table, const std::string& path, T&& resource) {
+    auto entry = std::make_shared<typename ResourceHandle<T>::Entry>();
+    entry->path = path;
+    entry->bytes = residentSize(resource, path);
+    entry->resource = std::move(resource);
+    entry->loaded = true;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    return table.emplace(path, std::move(entry)).second;
+}
+
+ResourceHandle<sf::Texture> ResourceCache::texture(const std::string& path) { return acquire<sf::Texture>(textures, path); }
+ResourceHandle<sf::Image> ResourceCache::image(const std::string& path) { return acquire<sf::Image>(images, path); }
+ResourceHandle<sf::SoundBuffer> ResourceCache::soundBuffer(const std::string& path) { return acquire<sf::SoundBuffer>(soundBuffers, path); }
+ResourceHandle<sf::Font> ResourceCache::font(const std::string& path) { return acquire<sf::Font>(fonts, path); }
+
+bool ResourceCache::adopt(const std::string& path, sf::Texture&& texture) { return insert<sf::Texture>(textures, path, std::move(texture)); }
+bool ResourceCache::adopt(const std::string& path, sf::Image&& image) { return insert<sf::Image>(images, path, std::move(image)); }
+bool ResourceCache::adopt(const std::string& path, sf::SoundBuffer&& buffer) { return insert<sf::SoundBuffer>(soundBuffers, path, std::move(buffer)); }
+bool ResourceCache::adopt(const std::string& path, sf::Font&& font) { return insert<sf::Font>(fonts, path, std::move(font)); }
+
+std::size_t ResourceCache::purgeUnused() {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::size_t purged = 0;
+    auto purge = [&](auto& table) {
+        for (auto it = table.begin(); it != table.end();) {
+            if (it->second.use_count() == 1) {
+                it = table.erase(it);
+                purged++;
+            } else {
+                ++it;
+            }
+        }
+    };
+    purge(textures);
+    purge(images);
+    purge(soundBuffers);
+    purge(fonts);
+    return purged;
+}
+
+void ResourceCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    textures.clear();
+    images.clear();
+    soundBuffers.clear();
+    fonts.clear();
+}
+
+std::size_t ResourceCache::residentBytes() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::size_t total = 0;
+    auto sum = [&](const auto& table) {
+        for (const auto& [path, entry] : table) total += entry->bytes;
+    };
+    sum(textures);
+    sum(images);
+    sum(soundBuffers);
+    sum(fonts);
+    return total;
+}
+
+void ResourceCache::report(std::ostream& out) const {
+    struct Row {
+        const char* kind;
+        const std::string* path;
+        long users;
+        std::size_t bytes;
+        bool loaded;
+    };
+
+    std::vector<Row> rows;
+    std::lock_guard<std::mutex> lock(mutex);
+    auto collect = [&](const char* kind, const auto& table) {
+        for (const auto& [path, entry] : table) {
+            // The cache's own reference isn't a user
+            rows.push_back({kind, &path, entry.use_count() - 1, entry->bytes, entry->loaded});
+        }
+    };
+    collect("texture", textures);
+    collect("image", images);
+    collect("sound", soundBuffers);
+    collect("font", fonts);
+
+    // Biggest first
+    std::sort(rows.begin(), rows.end(), [](const Row& a, const Row& b) { return a.bytes > b.bytes; });
+
+    std::size_t total = 0;
+    out << std::left << std::setw(8) << "kind" << std::right << std::setw(6) << "users" << std::setw(12) << "KiB"
+        << "  path\n";
+    for (const Row& row : rows) {
+        total += row.bytes;
+        out << std::left << std::setw(8) << row.kind << std::right << std::setw(6) << row.users << std::setw(12)
+            << std::fixed << std::setprecision(1) << row.bytes / 1024.0 << "  " << *row.path
+            << (row.loaded ? "" : " (failed)") << "\n";
+    }
+    out << rows.size() << " assets, " << std::setprecision(2) << total / (1024.0 * 1024.0) << " MiB resident"
+        << std::endl;
+}
@@ -0,0 +1,18 @@
+#include "SpatialHash.hpp"
+
+void SpatialHash::build() {
+    // About one bucket per entry; crowded cells share entries anyway
+    unsigned bits = 6;
+    while ((std::size_t{1} << bits) < staged.size()) bits++;
+    bucketBits = bits;
+    std::size_t bucketCount = std::size_t{1} << bits;
+
+    // Counting sort: histogram, prefix sum, scatter
+    bucketStart.assign(bucketCount + 1, 0);
+    for (const Entry &e : staged) bucketStart[bucketOf(e.key) + 1]++;
+    for (std::size_t b = 0; b < bucketCount; ++b) bucketStart[b + 1] += bucketStart[b];
+
+    entries.resize(staged.size());
+    scatterCursor.assign(bucketStart.begin(), bucketStart.end() - 1);
+    for (const Entry &e : staged) entries[scatterCursor[bucketOf(e.key)]++] = e;
+}
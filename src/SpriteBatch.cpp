@@ -0,0 +1,136 @@
+#include "SpriteBatch.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+SpriteBatch::SpriteBatch() : buffer(sf::PrimitiveType::Triangles, sf::VertexBuffer::Usage::Stream) {}
+
+void SpriteBatch::clear() {
+    items.clear();
+    staging.clear();
+    blends.clear();
+}
+
+std::uint8_t SpriteBatch::blendIndex(const sf::BlendMode& blend) {
+    for (std::size_t i = 0; i < blends.size(); ++i) {
+        if (blends[i] == blend) return static_cast<std::uint8_t>(i);
+    }
+    blends.push_back(blend);
+    return static_cast<std::uint8_t>(blends.size() - 1);
+}
+
+void SpriteBatch::pushQuad(int layer, const sf::Texture* texture, std::uint8_t blend,
+                           const sf::Vector2f (&corners)[4], const sf::IntRect& rect, sf::Color color) {
+    float left = static_cast<float>(rect.position.x);
+    float top = static_cast<float>(rect.position.y);
+    float right = left + rect.size.x;
+    float bottom = top + rect.size.y;
+    const sf::Vector2f texCoords[4] = {{left, top}, {right, top}, {right, bottom}, {left, bottom}};
+
+    // Two triangles; there are no index buffers in SFML
+    items.push_back({layer, texture, blend, static_cast<std::uint32_t>(staging.size()), 6});
+    static constexpr int order[6] = {0, 1, 2, 0, 2, 3};
+    for (int i : order) {
+        staging.push_back({corners[i], color, texCoords[i]});
+    }
+}
+
+void SpriteBatch::add(int layer, const sf::Sprite& sprite, const sf::BlendMode& blend) {
+    sf::IntRect rect = sprite.getTextureRect();
+    sf::Vector2f size(static_cast<float>(std::abs(rect.size.x)), static_cast<float>(std::abs(rect.size.y)));
+    const sf::Transform& transform = sprite.getTransform();
+    const sf::Vector2f corners[4] = {transform.transformPoint({0.f, 0.f}), transform.transformPoint({size.x, 0.f}),
+                                     transform.transformPoint(size), transform.transformPoint({0.f, size.y})};
+    pushQuad(layer, &sprite.getTexture(), blendIndex(blend), corners, rect, sprite.getColor());
+}
+
+void SpriteBatch::add(int layer, const sf::Texture& texture, const sf::IntRect& rect, sf::Vector2f position,
+                      sf::Vector2f origin, sf::Vector2f scale, sf::Color color, float rotation,
+                      const sf::BlendMode& blend) {
+    float w = static_cast<float>(std::abs(rect.size.x));
+    float h = static_cast<float>(std::abs(rect.size.y));
+    // Local corners relative to the origin, scaled
+    const sf::Vector2f local[4] = {{-origin.x * scale.x, -origin.y * scale.y},
+                                   {(w - origin.x) * scale.x, -origin.y * scale.y},
+                                   {(w - origin.x) * scale.x, (h - origin.y) * scale.y},
+                                   {-origin.x * scale.x, (h - origin.y) * scale.y}};
+
+    sf::Vector2f corners[4];
+    if (rotation == 0.f) {
+        for (int i = 0; i < 4; ++i) corners[i] = position + local[i];
+    } else {
+        float radians = rotation * 3.14159265f / 180.f;
+        float c = std::cos(radians), s = std::sin(radians);
+        for (int i = 0; i < 4; ++i) {
+            corners[i] = {position.x + local[i].x * c - local[i].y * s, position.y + local[i].x * s + local[i].y * c};
+        }
+    }
+    pushQuad(layer, &texture, blendIndex(blend), corners, rect, color);
+}
+
+void SpriteBatch::addCircle(int layer, sf::Vector2f center, float radius, sf::Color color, unsigned pointCount,
+                            const sf::BlendMode& blend) {
+    items.push_back({layer, nullptr, blendIndex(blend), static_cast<std::uint32_t>(staging.size()), pointCount * 3});
+    // Same outline points as sf::CircleShape (first point at the top)
+    const float step = 2.f * 3.14159265f / pointCount;
+    sf::Vector2f previous = center + sf::Vector2f(0.f, -radius);
+    for (unsigned i = 1; i <= pointCount; ++i) {
+        float angle = i * step - 3.14159265f / 2.f;
+        sf::Vector2f next = center + sf::Vector2f(std::cos(angle) * radius, std::sin(angle) * radius);
+        staging.push_back({center, color, {}});
+        staging.push_back({previous, color, {}});
+        staging.push_back({next, color, {}});
+        previous = next;
+    }
+}
+
+void SpriteBatch::flush(sf::RenderTarget& target) {
+    lastDrawCalls = 0;
+    if (items.empty()) return;
+
+    std::stable_sort(items.begin(), items.end(), [](const Item& a, const Item& b) {
+        if (a.layer != b.layer) return a.layer < b.layer;
+        if (a.texture != b.texture) return std::less<const sf::Texture*>()(a.texture, b.texture);
+        return a.blend < b.blend;
+    });
+
+    sorted.resize(staging.size());
+    std::size_t offset = 0;
+    for (Item& item : items) {
+        std::copy_n(staging.begin() + item.first, item.count, sorted.begin() + offset);
+        item.first = static_cast<std::uint32_t>(offset);
+        offset += item.count;
+    }
+
+    if (sf::VertexBuffer::isAvailable() && buffer.getVertexCount() < sorted.size()) {
+        // Headroom so a growing scene doesn't reallocate every frame
+        if (!buffer.create(sorted.size() + sorted.size() / 2)) {
+            std::cerr << "Failed to create sprite batch vertex buffer" << std::endl;
+        }
+    }
+    bool useBuffer = buffer.getVertexCount() >= sorted.size() && buffer.update(sorted.data(), sorted.size(), 0);
+
+    // One draw per run of identical state
+    for (std::size_t i = 0; i < items.size();) {
+        std::size_t j = i + 1;
+        while (j < items.size() && items[j].layer == items[i].layer && items[j].texture == items[i].texture &&
+               items[j].blend == items[i].blend) {
+            ++j;
+        }
+        std::size_t first = items[i].first;
+        std::size_t count = items[j - 1].first + items[j - 1].count - first;
+
+        sf::RenderStates states;
+        states.texture = items[i].texture;
+        states.blendMode = blends[items[i].blend];
+        if (useBuffer) {
+            target.draw(buffer, first, count, states);
+        } else {
+            target.draw(sorted.data() + first, count, sf::PrimitiveType::Triangles, states);
+        }
+        lastDrawCalls++;
+        i = j;
+    }
+
+    clear();
+}
@@ -0,0 +1,60 @@
+#include "TextureAtlas.hpp"
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+
+int TextureAtlas::addFromFile(const std::string& path) {
+    sf::Image image;
+    if (!image.loadFromFile(path)) {
+        std::cerr << "Failed to load: " << path << std::endl;
+        return -1;
+    }
+    return add(image);
+}
+
+int TextureAtlas::add(const sf::Image& image) {
+    pending.push_back(image);
+    regions.emplace_back();
+    return static_cast<int>(regions.size() - 1);
+}
+
+bool TextureAtlas::build(unsigned maxWidth) {
+    if (pending.empty()) return false;
+
+    std::vector<std::size_t> order(pending.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+        return pending[a].getSize().y > pending[b].getSize().y;
+    });
+
+    // Place left to right, starting a new shelf when a row is full
+    unsigned x = 0, y = 0, shelfHeight = 0, usedWidth = 0;
+    for (std::size_t i : order) {
+        sf::Vector2u size = pending[i].getSize();
+        if (x > 0 && x + size.x > maxWidth) {
+            x = 0;
+            y += shelfHeight + padding;
+            shelfHeight = 0;
+        }
+        regions[i] = sf::IntRect({static_cast<int>(x), static_cast<int>(y)},
+                                 {static_cast<int>(size.x), static_cast<int>(size.y)});
+        x += size.x + padding;
+        shelfHeight = std::max(shelfHeight, size.y);
+        usedWidth = std::max(usedWidth, x);
+    }
+
+    sf::Image atlas({usedWidth, y + shelfHeight}, sf::Color::Transparent);
+    for (std::size_t i = 0; i < pending.size(); ++i) {
+        sf::Vector2u dest(static_cast<unsigned>(regions[i].position.x), static_cast<unsigned>(regions[i].position.y));
+        if (!atlas.copy(pending[i], dest)) {
+            std::cerr << "Failed to copy image into atlas" << std::endl;
+        }
+    }
+    pending.clear();
+
+    if (!texture.loadFromImage(atlas)) {
+        std::cerr << "Failed to create atlas texture (" << usedWidth << "x" << y + shelfHeight << ")" << std::endl;
+        return false;
+    }
+    return true;
+}
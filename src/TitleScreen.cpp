@@ -3,32 +3,27 @@
 #include <cmath>
 #include <algorithm>
 
-TitleScreen::TitleScreen() : titleSprite(titleTexture), clickSound(clickBuffer), selectedOption(0), time(0.f), creditsText(font), backText(font), howToPlayText(font) {
+TitleScreen::TitleScreen()
+    : font(ResourceCache::instance().font("resources/Font/Jumps Winter.ttf")),
+      titleTexture(ResourceCache::instance().texture("resources/Title.png")),
+      titleSprite(*titleTexture),
+      clickBuffer(ResourceCache::instance().soundBuffer("resources/UI_Button.wav")),
+      clickSound(*clickBuffer), selectedOption(0), time(0.f), creditsText(*font), backText(*font), howToPlayText(*font) {
     optionLabels = {"PLAY", "HOW TO PLAY", "CREDITS", "EXIT"};
 }
 
 bool TitleScreen::init(float width, float height) {
-    // Try to load custom font
-    if (!font.openFromFile("resources/Font/Jumps Winter.ttf")) {
-        // Fallback or error handling
-        std::cerr << "Failed to load font resources/Font/Jumps Winter.ttf" << std::endl;
+    // Font, title and click sound come from the shared cache (the font is
+    // the same face as Window::UiFont); the cache has already logged failures
+    if (!font.loaded()) {
         return false;
     }
 
-    // Load sound
-    if (!clickBuffer.loadFromFile("resources/UI_Button.wav")) {
-        std::cerr << "Failed to load sound resources/UI_Button.wav" << std::endl;
-        // We continue even if sound fails, just don't play it
-    } else {
-        clickSound.setBuffer(clickBuffer);
-    }
-
     // Setup Title
-    if (!titleTexture.loadFromFile("resources/Title.png")) {
-        std::cerr << "Failed to load resources/Title.png" << std::endl;
+    if (!titleTexture.loaded()) {
         return false;
     }
-    titleSprite.setTexture(titleTexture, true);
+    titleSprite.setTexture(*titleTexture, true);
     
     sf::FloatRect titleBounds = titleSprite.getLocalBounds();
     titleSprite.setOrigin({titleBounds.size.x / 2.f, titleBounds.size.y / 2.f});
@@ -37,7 +32,7 @@ bool TitleScreen::init(float width, float height) {
     // Setup Options
     for (size_t i = 0; i < optionLabels.size(); ++i) {
         // Main Option Text
-        sf::Text text(font);
+        sf::Text text(*font);
         text.setString(optionLabels[i]);
         text.setCharacterSize(50);
         
@@ -49,7 +44,7 @@ bool TitleScreen::init(float width, float height) {
     }
     
     // Setup Credits Text
-    creditsText.setFont(font);
+    creditsText.setFont(*font);
     creditsText.setString("A Game By : Tejasva Gupta");
     creditsText.setCharacterSize(40);
     creditsText.setFillColor(sf::Color::White);
@@ -58,7 +53,7 @@ bool TitleScreen::init(float width, float height) {
     creditsText.setPosition({width / 2.f, height / 2.f});
 
     // Setup How To Play Text
-    howToPlayText.setFont(font);
+    howToPlayText.setFont(*font);
     howToPlayText.setString(
         "CONTROLS\n\n"
         "WASD / ARROWS  -  MOVE\n"
@@ -74,7 +69,7 @@ bool TitleScreen::init(float width, float height) {
     howToPlayText.setOrigin({htpBounds.size.x / 2.f, htpBounds.size.y / 2.f});
     howToPlayText.setPosition({width / 2.f, height / 2.f});
     
-    backText.setFont(font);
+    backText.setFont(*font);
     backText.setString("Press any key to return");
     backText.setCharacterSize(20);
     backText.setFillColor(sf::Color(200, 200, 200));
@@ -0,0 +1,530 @@
+#include "World.hpp"
+#include "Profiler.hpp"
+#include "JobSystem.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// Helper for ray-box intersection
+bool rayBoxIntersect(sf::Vector2f rayOrigin, sf::Vector2f rayDir, sf::FloatRect box, float& distance) {
+    float tmin = 0.0f;
+    float tmax = std::numeric_limits<float>::max();
+
+    sf::Vector2f min = {box.position.x, box.position.y};
+    sf::Vector2f max = {box.position.x + box.size.x, box.position.y + box.size.y};
+
+    // X axis
+    if (std::abs(rayDir.x) < 0.0001f) {
+        if (rayOrigin.x < min.x || rayOrigin.x > max.x) return false;
+    } else {
+        float ood = 1.0f / rayDir.x;
+        float t1 = (min.x - rayOrigin.x) * ood;
+        float t2 = (max.x - rayOrigin.x) * ood;
+        if (t1 > t2) std::swap(t1, t2);
+        tmin = std::max(tmin, t1);
+        tmax = std::min(tmax, t2);
+        if (tmin > tmax) return false;
+    }
+
+    // Y axis
+    if (std::abs(rayDir.y) < 0.0001f) {
+        if (rayOrigin.y < min.y || rayOrigin.y > max.y) return false;
+    } else {
+        float ood = 1.0f / rayDir.y;
+        float t1 = (min.y - rayOrigin.y) * ood;
+        float t2 = (max.y - rayOrigin.y) * ood;
+        if (t1 > t2) std::swap(t1, t2);
+        tmin = std::max(tmin, t1);
+        tmax = std::min(tmax, t2);
+        if (tmin > tmax) return false;
+    }
+
+    distance = tmin;
+    return true;
+}
+
+World::World(sf::Vector2f viewSize)
+    : viewSize(viewSize), cameraCenter(viewSize / 2.f) {
+    orbs.reserve(16);
+    shockwaveRipples.reserve(4);
+    coins.reserve(128);
+}
+
+void World::seed(std::uint32_t masterSeed) {
+    rng.seed(masterSeed, RngStream::World);
+    enemies.rng.seed(masterSeed, RngStream::Enemies);
+    particleSystem.rng.seed(masterSeed, RngStream::Particles);
+    screenShake.rng.seed(masterSeed, RngStream::ScreenShake);
+}
+
+void World::reset(sf::Vector2f spawnPos) {
+    player = std::make_unique<Player>(spawnPos.x, spawnPos.y);
+    cameraCenter = spawnPos;
+
+    enemies.clear();
+    enemies.reserve(maxEnemyCount);
+    orbs.clear();
+    coins.clear();
+    settledCoins = 0;
+    shockwaveRipples.clear();
+    particleSystem.clear();
+
+    totalCoins = 0;
+    difficulty = 1.f;
+    difficultyTimeOffset = 0.f;
+    elapsed = 0.f;
+    tick = 0;
+    gameOver = false;
+    laserHitting = false;
+    lastInput = {};
+    events.clear();
+
+    // Initial enemies
+    for (std::size_t i = 0; i < baseEnemyCount; ++i) {
+        enemies.spawn(getViewBounds(), difficulty);
+    }
+}
+
+sf::FloatRect World::getViewBounds(float margin) const {
+    sf::FloatRect bounds;
+    bounds.position = {cameraCenter.x - viewSize.x / 2.f - margin,
+                       cameraCenter.y - viewSize.y / 2.f - margin};
+    bounds.size = {viewSize.x + 2.f * margin,
+                   viewSize.y + 2.f * margin};
+    return bounds;
+}
+
+namespace {
+
+struct StateHasher {
+    std::uint64_t value = 14695981039346656037ull;
+
+    void bytes(const void* data, std::size_t size) {
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        for (std::size_t i = 0; i < size; ++i) {
+            value ^= p[i];
+            value *= 1099511628211ull;
+        }
+    }
+    template <typename T>
+    void add(const T& v) { bytes(&v, sizeof(v)); }
+    void add(sf::Vector2f v) { add(v.x); add(v.y); }
+};
+
+} // namespace
+
+std::uint64_t World::stateHash() const {
+    StateHasher h;
+    h.add(tick);
+    h.add(totalCoins);
+    h.add(difficulty);
+    h.add(gameOver);
+    if (player) {
+        h.add(player->position);
+        h.add(player->velX);
+        h.add(player->velY);
+        h.add(player->rotation);
+        h.add(player->HP);
+        h.add(player->laserEnergy);
+        h.add(player->nitroCharge);
+        h.add(player->shockwaveCharges);
+    }
+    std::size_t enemyCount = enemies.size();
+    h.add(enemyCount);
+    h.bytes(enemies.posX.data(), enemyCount * sizeof(float));
+    h.bytes(enemies.posY.data(), enemyCount * sizeof(float));
+    h.bytes(enemies.hp.data(), enemyCount * sizeof(float));
+    h.add(coins.size());
+    for (const auto& coin : coins) {
+        h.add(coin.position);
+        h.add(coin.value);
+    }
+    h.add(orbs.size());
+    for (const auto& orb : orbs) h.add(orb.position);
+    return h.value;
+}
+
+void World::step(const PlayerInput& input) {
+    if (gameOver || !player) return;
+
+    // Snapshot last tick's positions for render interpolation
+    player->prevPosition = player->position;
+    enemies.snapshot();
+    for (auto& coin : coins) coin.prevPosition = coin.position;
+    for (auto& orb : orbs) orb.prevPosition = orb.position;
+
+    elapsed += tickDt;
+    tick++;
+
+    difficulty = 1.f + (elapsed - difficultyTimeOffset) / 60.f;
+    if (difficulty < 1.f) difficulty = 1.f; // Ensure difficulty doesn't drop below 1
+    difficulty = std::min(difficulty, 5.f);
+
+    {
+        PROFILE_SCOPE(Spawn);
+        std::size_t targetEnemyCount = std::min<std::size_t>(maxEnemyCount, static_cast<std::size_t>(baseEnemyCount * difficulty));
+        while (enemies.size() < targetEnemyCount) {
+            enemies.spawn(getViewBounds(), difficulty);
+        }
+        enemies.buildGrid(enemyGrid);
+    }
+
+    cameraCenter = player->position;
+
+    screenShake.update(tickDt);
+    {
+        PROFILE_SCOPE(Particles);
+        particleSystem.update(tickDt);
+    }
+
+    updatePlayer(input);
+    cameraCenter = player->position;
+
+    // Beams ride on the ship, so only their fade needs ticking
+    for (auto& beam : player->beams) beam.update(tickDt);
+
+    updatePickups();
+    updateEnemies();
+
+    lastInput = input;
+}
+
+void World::updatePlayer(const PlayerInput& input) {
+    bool nitroActive = player->updateNitro(input.nitro, tickDt);
+    player->maxSpeed = nitroActive ? player->nitroMaxSpeed : player->baseMaxSpeed;
+    float accelBoost = nitroActive ? player->nitroAccelMultiplier : 1.f;
+    float thrust = player->baseAcceleration * accelBoost * tickDt;
+    float frictionBase = nitroActive ? player->baseFriction * player->nitroFrictionFactor : player->baseFriction;
+    float friction = frictionBase * (tickDt * 60.f);
+    friction = std::clamp(friction, 0.01f, 0.3f);
+
+    bool isMoving = false;
+    if (input.up) {
+        isMoving = true;
+        if (player->velY > -player->maxSpeed)
+            player->accY = -(0.05f * player->velY) - thrust;
+    }
+    if (input.down) {
+        isMoving = true;
+        if (player->velY < player->maxSpeed)
+            player->accY = -(0.05f * player->velY) + thrust;
+    }
+    if (input.left) {
+        isMoving = true;
+        if (player->velX > -player->maxSpeed)
+            player->accX = -(0.05f * player->velX) - thrust;
+    }
+    if (input.right) {
+        isMoving = true;
+        if (player->velX < player->maxSpeed)
+            player->accX = -(0.05f * player->velX) + thrust;
+    }
+
+    // Particle Emission for Movement
+    float speedSq = player->velX * player->velX + player->velY * player->velY;
+    if (speedSq > 100.f) { // Only emit if moving
+        sf::Vector2f velocity(player->velX, player->velY);
+        sf::Vector2f direction = -velocity; // Opposite to movement
+        float len = std::sqrt(direction.x*direction.x + direction.y*direction.y);
+        if (len > 0.001f) direction /= len;
+
+        // Randomize position slightly for trail thickness
+        sf::Vector2f pos = player->position;
+        pos.x += rng.uniform(-10.f, 10.f);
+        pos.y += rng.uniform(-10.f, 10.f);
+
+        // Cone emission
+        particleSystem.emitCone(pos, direction, 0.5f, 1, sf::Color::White, 100.f);
+    }
+
+    player->updateThrust(isMoving);
+    player->updateLaserEnergy(tickDt);
+
+    laserHitting = false;
+    bool didShoot = false;
+    if (input.fire && player->canShoot()) {
+        fireLaser(input);
+        didShoot = true;
+    }
+    if (didShoot) {
+        events.publish(LaserFired{!player->wasShooting});
+    }
+    player->wasShooting = didShoot;
+
+    // Shockwave on the press edge of the right mouse button
+    if (input.shockwave && !lastInput.shockwave) {
+        if (player->activateShockwave()) {
+            shockwaveRipples.emplace_back(player->position);
+
+            // Multiply the difficulty by 3/4
+            // Current difficulty: D = 1 + (T - Offset) / 60
+            // Target difficulty: D' = D * 0.75
+            // NewOffset = T - 60 * (D*0.75 - 1)
+            float targetD = difficulty * 0.75f;
+            if (targetD < 1.f) targetD = 1.f;
+            difficultyTimeOffset = elapsed - (targetD - 1.f) * 60.f;
+        }
+    }
+
+    player->updateShockwave(tickDt);
+
+    shockwaveRipples.erase(std::remove_if(shockwaveRipples.begin(), shockwaveRipples.end(),
+        [&](ShockwaveRipple& r) { return !r.update(tickDt); }),
+        shockwaveRipples.end());
+
+    // Repair Mechanic
+    if (input.repair && !lastInput.repair) {
+        if (totalCoins >= repairCost && player->HP < player->maxHP) {
+            totalCoins -= repairCost;
+            player->HP = player->maxHP;
+            events.publish(Repaired{player->position, repairCost});
+        }
+    }
+
+    player->deaccelerate(player->velY, player->accY, false, friction);
+    player->deaccelerate(player->velX, player->accX, true, friction);
+    player->RotateTowards(input.aim);
+    player->diagonalhandle();
+}
+
+void World::fireLaser(const PlayerInput& input) {
+    PROFILE_SCOPE(Laser);
+    sf::Vector2f playerPos = player->position;
+    sf::Vector2f dir = input.aim - playerPos;
+    float len = std::sqrt(dir.x*dir.x + dir.y*dir.y);
+    if (len > 0.0001f) dir /= len;
+
+    for (auto& beam : player->beams) {
+        if (!beam.mounted) continue;
+        float angleDeg = player->rotation - 90.f + beam.angleOffset;
+        sf::Vector2f beamDir = dir;
+        if (beam.angleOffset != 0.f) {
+            float rad = beam.angleOffset * 3.14159265f / 180.f;
+            float c = std::cos(rad), s = std::sin(rad);
+            beamDir = {dir.x * c - dir.y * s, dir.x * s + dir.y * c};
+        }
+
+        // Raycast through the enemy grid; only cells under the beam are tested
+        float minDistance = maxLaserLength;
+        std::uint32_t hitEnemy = enemyGrid.raycast(playerPos, beamDir, maxLaserLength, minDistance,
+                                                   [&](std::uint32_t i, float &dist) {
+                                                       return rayBoxIntersect(playerPos, beamDir, enemies.getBounds(i), dist);
+                                                   });
+
+        beam.fire(minDistance);
+
+        if (hitEnemy != SpatialHash::noHit) {
+            enemies.takeDamage(hitEnemy, laserDamagePerTick);
+            enemies.applyKnockback(hitEnemy, beamDir, 0.5f);
+
+            sf::Vector2f hitPos = playerPos + beamDir * (minDistance - 10.f);
+            if (!laserHitting) { // The splash shows the first beam that hits
+                laserHitting = true;
+                laserHitPos = hitPos;
+                laserHitAngle = angleDeg;
+            }
+            events.publish(LaserHit{hitPos, laserDamagePerTick, enemies.serial[hitEnemy]});
+        }
+    }
+
+    // One charge per tick however many beams are mounted
+    player->consumeLaserEnergy();
+}
+
+void World::updatePickups() {
+    PROFILE_SCOPE(Pickups);
+    sf::FloatRect viewBounds = getViewBounds(64.f);
+    float leftBound = viewBounds.position.x;
+    float rightBound = viewBounds.position.x + viewBounds.size.x;
+    float topBound = viewBounds.position.y;
+    float bottomBound = viewBounds.position.y + viewBounds.size.y;
+
+    // Update orbs, check for collection, and remove off-screen orbs in one pass
+    sf::Vector2f playerPos = player->position;
+    orbs.erase(std::remove_if(orbs.begin(), orbs.end(),
+                              [&](ShockwaveOrb &orb) {
+                                  orb.update(playerPos, tickDt);
+                                  if (orb.isCollected(playerPos)) {
+                                      player->addShockwaveCharge();
+                                      events.publish(OrbCollected{orb.position});
+                                      return true;
+                                  }
+                                  sf::Vector2f p = orb.position;
+                                  return p.x < leftBound || p.y < topBound || p.x > rightBound || p.y > bottomBound;
+                              }),
+               orbs.end());
+
+    // Resting coins go through the grid: one radius query wakes everything
+    // inside the magnet radius. The collect radius is smaller, so a coin can
+    // only be collected once it is magnetized and flying at the player.
+    coinGrid.clear();
+    for (std::size_t i = 0; i < coins.size(); ++i) {
+        if (!coins[i].magnetized) coinGrid.insert(static_cast<std::uint32_t>(i), coins[i].position);
+    }
+    coinGrid.build();
+
+    // Drops from last tick fold into whatever resting coin they landed on.
+    // Merged coins keep value 0 until the erase below.
+    for (std::size_t i = settledCoins; i < coins.size(); ++i) mergeCoin(i, Coin::mergeRadius);
+
+    bool despawnSweep = tick % coinDespawnInterval == 0;
+    if (despawnSweep) clusterCoins();
+
+    coinGrid.forEachInRadius(playerPos, Coin::magnetRadius, [&](std::uint32_t i) {
+        sf::Vector2f diff = playerPos - coins[i].position;
+        if (diff.x * diff.x + diff.y * diff.y < Coin::magnetRadius * Coin::magnetRadius) coins[i].magnetized = true;
+    });
+
+    // Homing only touches each coin itself, so it runs as jobs ahead of the
+    // serial collect/erase pass
+    JobSystem::instance().parallelFor(coins.size(), coinJobGrain, [&](std::size_t begin, std::size_t end, std::size_t) {
+        for (std::size_t i = begin; i < end; ++i) {
+            if (coins[i].magnetized && coins[i].value != 0) coins[i].update(playerPos, tickDt);
+        }
+    });
+
+    coins.erase(std::remove_if(coins.begin(), coins.end(),
+                               [&](Coin &c) {
+                                   if (c.value == 0) return true; // Merged away
+                                   if (!c.magnetized) {
+                                       // Despawn if too far
+                                       return despawnSweep && c.isTooFar(playerPos);
+                                   }
+                                   if (c.isCollected(playerPos)) {
+                                       totalCoins += c.value;
+                                       events.publish(CoinCollected{c.position, c.value});
+                                       return true;
+                                   }
+                                   return c.isTooFar(playerPos);
+                               }),
+                coins.end());
+    settledCoins = coins.size();
+}
+
+// Moves coin i's value into the nearest other resting coin within radius.
+// Coins past the despawn distance are never targets, or the value would be
+// erased with them. Only valid while coinGrid matches the coins vector.
+bool World::mergeCoin(std::size_t i, float radius) {
+    Coin& coin = coins[i];
+    if (coin.magnetized || coin.value == 0) return false;
+
+    sf::Vector2f playerPos = player->position;
+    std::size_t target = coins.size();
+    float bestDistSq = radius * radius;
+    coinGrid.forEachInRadius(coin.position, radius, [&](std::uint32_t j) {
+        const Coin& other = coins[j];
+        if (j == i || other.value == 0 || other.magnetized || other.isTooFar(playerPos)) return;
+        sf::Vector2f diff = other.position - coin.position;
+        float distSq = diff.x * diff.x + diff.y * diff.y;
+        if (distSq < bestDistSq) {
+            bestDistSq = distSq;
+            target = j;
+        }
+    });
+    if (target == coins.size()) return false;
+
+    coins[target].value += coin.value;
+    coin.value = 0;
+    return true;
+}
+
+// Runs on the despawn sweep. Resting coins the player can't see are only
+// waiting to be picked up later, so they gather into clusters. If too many
+// are still resting after that, the radius widens for the off-screen ones
+// until the count is under the cap; coins in view never jump, even if that
+// leaves the count over it. Value is moved, never dropped.
+void World::clusterCoins() {
+    sf::FloatRect view = getViewBounds();
+    std::size_t resting = 0;
+    for (std::size_t i = 0; i < coins.size(); ++i) {
+        Coin& c = coins[i];
+        if (c.magnetized || c.value == 0) continue;
+        if (!view.contains(c.position) && mergeCoin(i, Coin::clusterRadius)) continue;
+        resting++;
+    }
+
+    for (float radius = Coin::clusterRadius; resting > maxRestingCoins && radius <= 1024.f; radius *= 2.f) {
+        for (std::size_t i = 0; i < coins.size() && resting > maxRestingCoins; ++i) {
+            if (!view.contains(coins[i].position) && mergeCoin(i, radius)) resting--;
+        }
+    }
+}
+
+void World::killEnemy(std::size_t i) {
+    sf::Vector2f pos = enemies.position(i);
+    events.publish(EnemyKilled{pos});
+
+    // Spawn shockwave orb when enemy is killed
+    if (rng.chance(orbDropProbability)) {
+        orbs.emplace_back(pos);
+    }
+
+    int coinCount = rng.range(1, 3);
+    for (int c = 0; c < coinCount; ++c) {
+        float offsetX = static_cast<float>(rng.range(-20, 20));
+        float offsetY = static_cast<float>(rng.range(-20, 20));
+        sf::Vector2f offset = {offsetX, offsetY};
+        coins.emplace_back(pos + offset);
+    }
+
+    enemies.respawn(i, getViewBounds(), difficulty);
+}
+
+void World::updateEnemies() {
+    PROFILE_SCOPE(Enemies);
+    sf::Vector2f playerPos = player->position;
+
+    enemies.updateTrails(tickDt);
+
+    // Batch tests against pre-move positions, then move the whole swarm.
+    // Enemies that die, explode or get recycled below are respawned, which
+    // overrides this tick's move.
+    enemies.classify(playerPos, {player->velX, player->velY}, getViewBounds());
+    enemies.markNearPlayer(enemyGrid, playerPos);
+
+    // Shockwave freezes the swarm while it is active
+    if (!player->shockwaveActive) {
+        enemies.seek(playerPos, tickDt);
+    }
+
+    // Scan the flags in parallel; each chunk records its enemies' events in
+    // index order. Applying them draws from the shared rng and spawns
+    // pickups, so that happens serially, in chunk order, exactly as one
+    // loop over the pool would. Handling an event only changes that
+    // enemy's own flags, so scanning them all up front is equivalent.
+    constexpr std::uint8_t eventMask = EnemyPool::Dead | EnemyPool::Recycle | EnemyPool::Explode;
+    JobSystem& jobs = JobSystem::instance();
+    enemyEvents.reset(JobSystem::chunkCount(enemies.size(), EnemyPool::jobGrain));
+    jobs.parallelFor(enemies.size(), EnemyPool::jobGrain, [&](std::size_t begin, std::size_t end, std::size_t chunk) {
+        auto& events = enemyEvents[chunk];
+        for (std::size_t i = begin; i < end; ++i) {
+            std::uint8_t f = enemies.flags[i];
+            if (!(f & eventMask)) continue;
+            EnemyEvent::Kind kind = (f & EnemyPool::Dead)      ? EnemyEvent::Kill
+                                    : (f & EnemyPool::Recycle) ? EnemyEvent::Recycle
+                                                               : EnemyEvent::Explode;
+            events.push_back({kind, static_cast<std::uint32_t>(i)});
+        }
+    });
+
+    enemyEvents.merge([&](const EnemyEvent& event) {
+        std::size_t i = event.index;
+        if (event.kind == EnemyEvent::Kill) {
+            killEnemy(i);
+        } else if (event.kind == EnemyEvent::Recycle) {
+            // Recycle enemies left behind off-screen while the player flies away
+            enemies.respawn(i, getViewBounds(), difficulty);
+        } else {
+            player->takeDamage(static_cast<int>(EnemyPool::explosionDamage));
+            events.publish(PlayerHit{playerPos, EnemyPool::explosionDamage, player->isDead()});
+
+            enemies.respawn(i, getViewBounds(), difficulty);
+
+            if (player->isDead()) {
+                gameOver = true;
+                return false;
+            }
+        }
+        return true;
+    });
+}
@@ -0,0 +1,70 @@
+#include "WorldEffects.hpp"
+#include "World.hpp"
+#include <algorithm>
+#include <array>
+#include <limits>
+
+namespace WorldEffects {
+
+namespace {
+
+struct Burst {
+    sf::Vector2f sum; // Of the kill positions, for the centroid
+    int kills = 0;
+
+    sf::Vector2f center() const { return sum / static_cast<float>(kills); }
+};
+
+float distanceSq(sf::Vector2f a, sf::Vector2f b) {
+    sf::Vector2f d = a - b;
+    return d.x * d.x + d.y * d.y;
+}
+
+} // namespace
+
+void subscribe(World& world) {
+    ParticleSystem& particles = world.particleSystem;
+    ScreenShake& shake = world.screenShake;
+
+    world.events.subscribe<EnemyKilled>([&particles, &shake](std::span<const EnemyKilled> kills) {
+        // Greedy clustering: each kill joins the nearest burst within the
+        // merge radius, or starts one while there's room, or else joins
+        // the nearest burst at any distance
+        std::array<Burst, maxKillBursts> bursts;
+        std::size_t used = 0;
+        for (const EnemyKilled& kill : kills) {
+            std::size_t nearest = 0;
+            float nearestDistSq = std::numeric_limits<float>::max();
+            for (std::size_t b = 0; b < used; ++b) {
+                float d = distanceSq(bursts[b].center(), kill.position);
+                if (d < nearestDistSq) {
+                    nearestDistSq = d;
+                    nearest = b;
+                }
+            }
+            bool join = used == bursts.size() || nearestDistSq < burstMergeRadius * burstMergeRadius;
+            Burst& burst = join ? bursts[nearest] : bursts[used++];
+            burst.sum += kill.position;
+            burst.kills++;
+        }
+
+        for (std::size_t b = 0; b < used; ++b) {
+            int count = std::min(bursts[b].kills * particlesPerKill, maxBurstParticles);
+            particles.emit(bursts[b].center(), count, sf::Color::Red, 150.f);
+        }
+        shake.addTrauma(std::min(killTrauma * static_cast<float>(kills.size()), maxKillTrauma));
+    });
+
+    world.events.subscribe<PlayerHit>([&particles, &shake](std::span<const PlayerHit> hits) {
+        // Hits all land on the ship, so one burst at the latest covers them
+        int count = std::min(static_cast<int>(hits.size()) * 30, maxBurstParticles);
+        particles.emit(hits.back().position, count, sf::Color::Red, 200.f);
+        shake.addTrauma(hitTrauma);
+    });
+
+    world.events.subscribe<LaserFired>([&shake](std::span<const LaserFired> shots) {
+        shake.addTrauma(laserTrauma * static_cast<float>(shots.size()));
+    });
+}
+
+} // namespace WorldEffects
@@ -0,0 +1,219 @@
+#include "WorldRenderer.hpp"
+#include "Profiler.hpp"
+#include <iostream>
+#include <algorithm>
+
+static ResourceHandle<sf::Texture> loadTexture(const std::string& path) {
+    return ResourceCache::instance().texture(path);
+}
+
+WorldRenderer::WorldRenderer()
+    : playerInitial(loadTexture("resources/Player/Initial.png")),
+      playerAccel(loadTexture("resources/Player/OnAcceleration.png")),
+      playerBoost(loadTexture("resources/Player/OnBoost.png")),
+      enemyInitial(loadTexture("resources/Enemy_Initial.png")),
+      enemyExplosion(loadTexture("resources/Enemy_BeforeExplosion.png")),
+      coinTexture(loadTexture("resources/Coin/Coin3.png")),
+      laserTexture(loadTexture("resources/Laser.png")),
+      playerSprite(*playerInitial), enemySprite(*enemyInitial), coinSprite(*coinTexture),
+      laserSprite(*laserTexture), hitSplash({0.f, 0.f}, 0.f),
+      particleBuffer(sf::PrimitiveType::Triangles, sf::VertexBuffer::Usage::Stream),
+      trailBuffer(sf::PrimitiveType::Lines, sf::VertexBuffer::Usage::Stream) {
+    // Scale sprite to match the enemy hitbox
+    sf::Vector2u texSize = enemyInitial->getSize();
+    if (texSize.x > 0 && texSize.y > 0) {
+        enemySprite.setScale({EnemyPool::width / texSize.x, EnemyPool::height / texSize.y});
+    }
+    enemySprite.setOrigin({texSize.x / 2.f, texSize.y / 2.f});
+    enemySprite.setColor(sf::Color::White);
+
+    coinSprite.setTexture(*coinTexture, true);
+    sf::FloatRect coinBounds = coinSprite.getLocalBounds();
+    coinSprite.setOrigin({coinBounds.size.x / 2.f, coinBounds.size.y / 2.f});
+    coinSprite.setScale({0.5f, 0.5f}); // 16px on screen
+
+    // Origin at middle-left (start of beam)
+    laserSprite.setOrigin({0.f, 17.f});
+
+    orbShape.setRadius(8.f);
+    orbShape.setOrigin({8.f, 8.f});
+    orbShape.setFillColor(sf::Color::Cyan);
+}
+
+void WorldRenderer::update(const World& world, float dt) {
+    if (world.laserHitting) {
+        hitSplash.setPosition(world.laserHitPos);
+        hitSplash.setRotation(world.laserHitAngle);
+        hitSplash.update(dt);
+    }
+}
+
+void WorldRenderer::batchPlayer(const Player& player, float alpha) {
+    switch (player.thrust) {
+        case Player::Thrust::Boosting: playerSprite.setTexture(*playerBoost, true); break;
+        case Player::Thrust::Accelerating: playerSprite.setTexture(*playerAccel, true); break;
+        case Player::Thrust::Idle: playerSprite.setTexture(*playerInitial, true); break;
+    }
+    // Re-center origin as texture size might change
+    sf::FloatRect bounds = playerSprite.getLocalBounds();
+    playerSprite.setOrigin({bounds.size.x / 2.f, (bounds.size.y / 2.f) - 12.f});
+    playerSprite.setPosition(interpolate(player.prevPosition, player.position, alpha));
+    playerSprite.setRotation(sf::degrees(player.rotation));
+    batch.add(PlayerLayer, playerSprite);
+}
+
+std::size_t WorldRenderer::buildParticleVertices(const ParticleSystem& particles, sf::Vertex* out) {
+    std::size_t count = particles.size();
+    const float half = 2.f; // 4px squares
+    sf::Vertex* v = out;
+    for (std::size_t i = 0; i < count; ++i, v += 6) {
+        float x = particles.posX[i];
+        float y = particles.posY[i];
+        sf::Color c = particles.color[i];
+        float alpha = std::min(particles.lifetime[i] / particles.maxLifetime[i], 1.f) * 255.f;
+        c.a = static_cast<std::uint8_t>(alpha);
+
+        v[0].position = {x - half, y - half};
+        v[1].position = {x + half, y - half};
+        v[2].position = {x - half, y + half};
+        v[3].position = {x + half, y - half};
+        v[4].position = {x + half, y + half};
+        v[5].position = {x - half, y + half};
+        for (int j = 0; j < 6; ++j) v[j].color = c;
+    }
+    return count * 6;
+}
+
+void WorldRenderer::drawParticles(sf::RenderWindow& window, const ParticleSystem& particles) {
+    PROFILE_SCOPE(DrawParticles);
+    // Sized once for the whole pool so nothing is allocated per frame.
+    // SFML has no index buffers, so each quad is two triangles.
+    std::size_t maxVertices = particles.capacity() * 6;
+    if (particleVertices.size() < maxVertices) {
+        particleVertices.resize(maxVertices);
+        if (sf::VertexBuffer::isAvailable() && !particleBuffer.create(maxVertices)) {
+            std::cerr << "Failed to create particle vertex buffer" << std::endl;
+        }
+    }
+
+    std::size_t vertexCount = buildParticleVertices(particles, particleVertices.data());
+    if (vertexCount == 0) return;
+    if (particleBuffer.getVertexCount() >= vertexCount &&
+        particleBuffer.update(particleVertices.data(), vertexCount, 0)) {
+        window.draw(particleBuffer, 0, vertexCount);
+    } else {
+        // No VBO support; fall back to a client-side draw of the same vertices
+        window.draw(particleVertices.data(), vertexCount, sf::PrimitiveType::Triangles);
+    }
+}
+
+void WorldRenderer::drawTrails(sf::RenderWindow& window, const EnemyPool& enemies) {
+    // Separate segments rather than one strip per enemy, so unrelated
+    // trails never get joined; colours match the old per-enemy LineStrip.
+    constexpr std::size_t segmentsPerTrail = TrailPool::maxPoints - 1;
+    std::size_t maxVertices = enemies.size() * segmentsPerTrail * 2;
+    if (trailVertices.size() < maxVertices) {
+        // Grow with headroom so a rising enemy count doesn't recreate the buffer every tick
+        trailVertices.resize(maxVertices + maxVertices / 2);
+        if (sf::VertexBuffer::isAvailable() && !trailBuffer.create(trailVertices.size())) {
+            std::cerr << "Failed to create trail vertex buffer" << std::endl;
+        }
+    }
+
+    const sf::Color color(255, 50, 50);
+    sf::Vertex* v = trailVertices.data();
+    for (std::size_t i = 0; i < enemies.size(); ++i) {
+        std::size_t length = enemies.trails.length(i);
+        if (length < 2) continue;
+
+        float fade = 150.f / length;
+        sf::Vector2f previous = enemies.trails.point(i, 0);
+        sf::Color previousColor(color.r, color.g, color.b, 150);
+        for (std::size_t k = 1; k < length; ++k) {
+            sf::Vector2f current = enemies.trails.point(i, k);
+            sf::Color currentColor(color.r, color.g, color.b, static_cast<std::uint8_t>(150.f - fade * k));
+            *v++ = {previous, previousColor, {}};
+            *v++ = {current, currentColor, {}};
+            previous = current;
+            previousColor = currentColor;
+        }
+    }
+
+    std::size_t vertexCount = static_cast<std::size_t>(v - trailVertices.data());
+    if (vertexCount == 0) return;
+    if (trailBuffer.getVertexCount() >= vertexCount &&
+        trailBuffer.update(trailVertices.data(), vertexCount, 0)) {
+        window.draw(trailBuffer, 0, vertexCount);
+    } else {
+        window.draw(trailVertices.data(), vertexCount, sf::PrimitiveType::Lines);
+    }
+}
+
+void WorldRenderer::batchEnemies(const World& world, float alpha) {
+    // Quads are built straight from the packed arrays
+    const EnemyPool& enemies = world.enemies;
+    sf::IntRect rect = enemySprite.getTextureRect();
+    sf::Vector2f origin = enemySprite.getOrigin();
+    sf::Vector2f scale = enemySprite.getScale();
+    for (std::size_t i = 0; i < enemies.size(); ++i) {
+        bool nearPlayer = enemies.flags[i] & EnemyPool::NearPlayer;
+        batch.add(EnemyLayer, nearPlayer ? *enemyExplosion : *enemyInitial, rect,
+                  interpolate(enemies.prevPosition(i), enemies.position(i), alpha), origin, scale);
+    }
+}
+
+void WorldRenderer::drawEnemies(sf::RenderWindow& window, const World& world, float alpha) {
+    batchEnemies(world, alpha);
+    batch.flush(window);
+}
+
+void WorldRenderer::draw(sf::RenderWindow& window, const World& world, float alpha) {
+    PROFILE_SCOPE(DrawEntities);
+    const Player& player = *world.player;
+    sf::Vector2f playerDrawPos = interpolate(player.prevPosition, player.position, alpha);
+
+    // Draw Ripples (behind entities but above background)
+    for (const auto& ripple : world.shockwaveRipples) {
+        ripple.draw(window);
+    }
+
+    // Draw Particles (behind entities)
+    drawParticles(window, world.particleSystem);
+
+    // Trails sit under every sprite so they can be drawn before the batch
+    drawTrails(window, world.enemies);
+
+    // At most one sprite per mounted beam, however often the beam fires
+    for (const auto& beam : player.beams) {
+        if (!beam.visible()) continue;
+        // Crop the texture to the length required, but clamp to texture width (1400)
+        int rectWidth = std::min(static_cast<int>(beam.length), 1400);
+        batch.add(LaserLayer, *laserTexture, sf::IntRect({0, 0}, {rectWidth, 150}), playerDrawPos,
+                  laserSprite.getOrigin(), {1.f, 1.f}, sf::Color(255, 255, 255, beam.getAlpha()),
+                  player.rotation - 90.f + beam.angleOffset);
+    }
+
+    for (const auto& orb : world.orbs) {
+        batch.addCircle(OrbLayer, interpolate(orb.prevPosition, orb.position, alpha), orbShape.getRadius(),
+                        orbShape.getFillColor());
+    }
+
+    // Higher denominations are bigger and tinted, but share the texture so
+    // every coin still lands in one batch run
+    static const float coinTierScale[] = {1.f, 1.35f, 1.7f, 2.2f};
+    static const sf::Color coinTierColor[] = {sf::Color::White, sf::Color(255, 215, 120), sf::Color(255, 160, 70),
+                                              sf::Color(200, 140, 255)};
+    sf::IntRect coinRect = coinSprite.getTextureRect();
+    for (const auto& coin : world.coins) {
+        int tier = Coin::tier(coin.value);
+        batch.add(CoinLayer, *coinTexture, coinRect, interpolate(coin.prevPosition, coin.position, alpha),
+                  coinSprite.getOrigin(), coinSprite.getScale() * coinTierScale[tier], coinTierColor[tier]);
+    }
+
+    batchPlayer(player, alpha);
+    batchEnemies(world, alpha);
+    if (world.laserHitting)
+        batch.add(SplashLayer, hitSplash.sprite);
+
+    batch.flush(window);
+}
@@ -0,0 +1,76 @@
+// Background streaming benchmark: flies the camera in a straight line at
+// full nitro and reports how long Background::update takes per frame.
+// Frames are paced at 60 Hz so the chunk worker gets real time to run.
+// Needs the resources folder and an OpenGL context for the atlas texture.
+//
+// Usage: lss_flight_bench [--seconds N] [--sync] [--diagonal]
+//
+// --sync generates every chunk on the main thread (the old behaviour) for
+// comparison.
+
+#include "Background.hpp"
+#include "player.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+int main(int argc, char** argv) {
+    float seconds = 20.f;
+    bool async = true;
+    bool diagonal = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--seconds" && i + 1 < argc) seconds = std::strtof(argv[++i], nullptr);
+        else if (arg == "--sync") async = false;
+        else if (arg == "--diagonal") diagonal = true;
+        else {
+            std::cerr << "Usage: lss_flight_bench [--seconds N] [--sync] [--diagonal]" << std::endl;
+            return 1;
+        }
+    }
+
+    const sf::Vector2f viewSize(1920.f, 1080.f);
+    const float speed = Player(0.f, 0.f).nitroMaxSpeed; // Pixels per tick
+    sf::Vector2f velocity = diagonal ? sf::Vector2f(speed * 0.7071f, speed * 0.7071f) : sf::Vector2f(speed, 0.f);
+
+    Background background("resources", async);
+    sf::Vector2f camera;
+    background.update(camera, viewSize, velocity); // Initial fill isn't part of the flight
+    std::size_t initialSync = background.syncChunkCount;
+
+    using Clock = std::chrono::steady_clock;
+    const auto framePeriod = std::chrono::microseconds(16667);
+    int frames = static_cast<int>(seconds * 60.f);
+    std::vector<double> times;
+    times.reserve(frames);
+
+    auto nextFrame = Clock::now();
+    for (int f = 0; f < frames; ++f) {
+        camera += velocity;
+        auto start = Clock::now();
+        background.update(camera, viewSize, velocity);
+        times.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+
+        nextFrame += framePeriod;
+        std::this_thread::sleep_until(nextFrame);
+    }
+
+    std::vector<double> sorted = times;
+    std::sort(sorted.begin(), sorted.end());
+    auto percentile = [&](double p) { return sorted[static_cast<std::size_t>(p * (sorted.size() - 1))]; };
+    double total = 0.0;
+    for (double t : times) total += t;
+
+    std::cout << "mode:          " << (async ? "async" : "sync") << (diagonal ? " diagonal" : " straight") << "\n"
+              << "frames:        " << frames << " (" << seconds << " s at " << speed * 60.f << " px/s)\n"
+              << "update avg:    " << total / times.size() << " ms\n"
+              << "update p50:    " << percentile(0.50) << " ms\n"
+              << "update p99:    " << percentile(0.99) << " ms\n"
+              << "update max:    " << sorted.back() << " ms\n"
+              << "sync chunks:   " << background.syncChunkCount - initialSync << " (after initial fill)" << std::endl;
+    return 0;
+}
@@ -0,0 +1,395 @@
+// Microbenchmarks for the hot kernels. Every case times a fixed amount of
+// work per sample (setup is not timed) and reports the median, minimum and
+// 90th percentile over the samples.
+//
+// Usage: lss_micro_bench [--filter TEXT] [--quick] [--out FILE]
+//                        [--baseline FILE] [--threshold F]
+//
+// --out writes the results as CSV (name,param,samples,median_ns,min_ns,
+// p90_ns,ns_per_item). --baseline reads an earlier --out file and exits
+// with status 1 if any case's median is slower than the baseline by more
+// than the threshold (default 0.10 = 10%). Cases missing from either side
+// are listed but never fail the run. --quick runs the smaller sizes only.
+//
+// The background case needs the resources folder and an OpenGL context for
+// the atlas texture; the rest runs anywhere.
+
+#include "World.hpp"
+#include "WorldEffects.hpp"
+#include "WorldRenderer.hpp"
+#include "Background.hpp"
+#include "MusicGenerator.hpp"
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Result {
+    std::string name;
+    std::size_t param = 0;
+    std::size_t samples = 0;
+    double medianNs = 0.0;
+    double minNs = 0.0;
+    double p90Ns = 0.0;
+    double nsPerItem = 0.0;
+};
+
+struct Options {
+    std::string filter;
+    bool quick = false;
+    double minSeconds = 0.3; // Per case, after the warm-up sample
+    std::size_t minSamples = 5;
+    std::size_t maxSamples = 200;
+};
+
+// Keeps results alive so the optimiser can't drop the timed work
+volatile double sink = 0.0;
+
+class Runner {
+public:
+    explicit Runner(const Options& options) : options(options) {}
+
+    bool wants(const std::string& name) const {
+        return options.filter.empty() || name.find(options.filter) != std::string::npos;
+    }
+
+    // items is how much work one body() call does, for the per-item figure
+    void run(const std::string& name, std::size_t param, std::size_t items, const std::function<void()>& setup,
+             const std::function<void()>& body) {
+        using Clock = std::chrono::steady_clock;
+        setup();
+        body(); // Warm-up: caches, lazy allocations
+
+        std::vector<double> times;
+        auto caseStart = Clock::now();
+        while (times.size() < options.maxSamples &&
+               (times.size() < options.minSamples ||
+                std::chrono::duration<double>(Clock::now() - caseStart).count() < options.minSeconds)) {
+            setup();
+            auto start = Clock::now();
+            body();
+            times.push_back(std::chrono::duration<double, std::nano>(Clock::now() - start).count());
+        }
+
+        std::sort(times.begin(), times.end());
+        Result r;
+        r.name = name;
+        r.param = param;
+        r.samples = times.size();
+        r.medianNs = times[times.size() / 2];
+        r.minNs = times.front();
+        r.p90Ns = times[std::min(times.size() - 1, times.size() * 9 / 10)];
+        r.nsPerItem = items > 0 ? r.medianNs / items : r.medianNs;
+        results.push_back(r);
+
+        std::cout << std::left << std::setw(24) << name << std::right << std::setw(9) << param << std::fixed
+                  << std::setprecision(3) << std::setw(14) << r.medianNs / 1e6 << " ms" << std::setw(14)
+                  << r.nsPerItem << " ns/item" << std::setw(6) << r.samples << " samples" << std::endl;
+    }
+
+    const std::vector<Result>& all() const { return results; }
+
+private:
+    Options options;
+    std::vector<Result> results;
+};
+
+// A full laser sweep: 64 ray directions against every box
+void benchRayBox(Runner& runner, const std::vector<std::size_t>& sizes) {
+    if (!runner.wants("ray_box")) return;
+    constexpr int rays = 64;
+    std::vector<sf::Vector2f> dirs;
+    for (int r = 0; r < rays; ++r) {
+        float a = 6.2831853f * r / rays;
+        dirs.push_back({std::cos(a), std::sin(a)});
+    }
+    Rng rng(1);
+    for (std::size_t n : sizes) {
+        std::vector<sf::FloatRect> boxes(n);
+        for (auto& box : boxes) {
+            float x = rng.uniform(-2000.f, 2000.f);
+            float y = rng.uniform(-2000.f, 2000.f);
+            box = {{x, y}, {EnemyPool::width, EnemyPool::height}};
+        }
+        runner.run("ray_box", n, n * rays, [] {}, [&] {
+            float total = 0.f;
+            for (sf::Vector2f dir : dirs) {
+                for (const auto& box : boxes) {
+                    float dist;
+                    if (rayBoxIntersect({0.f, 0.f}, dir, box, dist)) total += dist;
+                }
+            }
+            sink = sink + total;
+        });
+    }
+}
+
+void fillParticles(ParticleSystem& particles, std::size_t n) {
+    particles.clear();
+    particles.rng.seed(2);
+    // Lifetimes start at 0.3 s, so nothing dies within one update
+    for (std::size_t i = 0; i < n; ++i) {
+        float x = particles.rng.uniform(-1000.f, 1000.f);
+        float y = particles.rng.uniform(-1000.f, 1000.f);
+        particles.emit({x, y}, 1, sf::Color::Red);
+    }
+}
+
+void benchParticles(Runner& runner, const std::vector<std::size_t>& sizes) {
+    for (std::size_t n : sizes) {
+        ParticleSystem particles((n + 3) & ~std::size_t{3});
+        if (runner.wants("particles_update")) {
+            runner.run("particles_update", n, n, [&] { fillParticles(particles, n); },
+                       [&] { particles.update(World::tickDt); });
+        }
+        if (runner.wants("particles_emit")) {
+            // Bursts the size of an enemy death; mostly random draws
+            runner.run("particles_emit", n, n, [&] { particles.clear(); },
+                       [&] {
+                           for (std::size_t i = 0; i < n; i += 30) particles.emit({0.f, 0.f}, 30, sf::Color::Red);
+                       });
+        }
+        if (runner.wants("particles_vertices")) {
+            std::vector<sf::Vertex> vertices(particles.capacity() * 6);
+            fillParticles(particles, n);
+            runner.run("particles_vertices", n, n, [] {}, [&] {
+                std::size_t count = WorldRenderer::buildParticleVertices(particles, vertices.data());
+                sink = sink + vertices[count / 2].position.x;
+            });
+        }
+    }
+}
+
+void benchBackground(Runner& runner, int frames) {
+    if (!runner.wants("background_flight")) return;
+    // Synchronous generation, so chunk building is timed on this thread.
+    // A fresh background per sample, so every sample builds its chunks.
+    const sf::Vector2f viewSize(1920.f, 1080.f);
+    const float speed = Player(0.f, 0.f).nitroMaxSpeed;
+    std::unique_ptr<Background> background;
+    runner.run("background_flight", static_cast<std::size_t>(frames), static_cast<std::size_t>(frames),
+               [&] {
+                   background.reset();
+                   background = std::make_unique<Background>("resources", false, 1234u);
+               },
+               [&] {
+                   sf::Vector2f camera;
+                   sf::Vector2f velocity(speed * 0.7071f, speed * 0.7071f);
+                   for (int f = 0; f < frames; ++f) {
+                       camera += velocity;
+                       background->update(camera, viewSize, velocity);
+                   }
+               });
+}
+
+void benchMusic(Runner& runner, std::size_t blocks) {
+    if (!runner.wants("music_block")) return;
+    MusicGenerator music;
+    music.setDifficulty(3.f);
+    runner.run("music_block", blocks, blocks, [] {}, [&] {
+        int total = 0;
+        for (std::size_t b = 0; b < blocks; ++b) total += music.render()[MusicGenerator::blockSize / 2];
+        sink = sink + total;
+    });
+}
+
+// Whole ticks with the swarm pinned at n; the enemy passes dominate as n grows
+void benchEnemies(Runner& runner, const std::vector<std::size_t>& sizes, int ticks) {
+    if (!runner.wants("world_enemies")) return;
+    const sf::Vector2f viewSize(1920.f, 1080.f);
+    for (std::size_t n : sizes) {
+        World world(viewSize);
+        world.baseEnemyCount = n;
+        world.maxEnemyCount = n;
+        world.seed(3);
+        world.reset(viewSize / 2.f);
+        WorldEffects::subscribe(world);
+        // Let the swarm close in first, so samples see collisions and kills
+        for (int t = 0; t < 120; ++t) {
+            world.step({});
+            world.events.dispatch();
+        }
+        PlayerInput input;
+        input.fire = true;
+        runner.run("world_enemies", n, static_cast<std::size_t>(ticks),
+                   [&] {
+                       world.player->HP = INT_MAX / 2; // Never die mid-sample
+                       world.gameOver = false;
+                   },
+                   [&] {
+                       for (int t = 0; t < ticks; ++t) {
+                           input.aim = world.player->position + sf::Vector2f(100.f, 0.f);
+                           world.step(input);
+                           world.events.dispatch();
+                       }
+                   });
+    }
+}
+
+// One tick with no enemies, so the orb and coin passes are what's timed
+void benchPickups(Runner& runner, const std::vector<std::size_t>& sizes) {
+    if (!runner.wants("pickups")) return;
+    const sf::Vector2f viewSize(1920.f, 1080.f);
+    for (std::size_t n : sizes) {
+        World world(viewSize);
+        world.baseEnemyCount = 0;
+        world.maxEnemyCount = 0;
+        world.seed(4);
+        Rng rng(4);
+        runner.run("pickups", n, n,
+                   [&] {
+                       world.reset(viewSize / 2.f);
+                       sf::Vector2f center = world.player->position;
+                       for (std::size_t i = 0; i < n; ++i) {
+                           float a = rng.uniform(0.f, 6.2831853f);
+                           float r = rng.uniform(100.f, 2000.f);
+                           sf::Vector2f pos = center + sf::Vector2f(std::cos(a) * r, std::sin(a) * r);
+                           if (i % 8 == 0) world.orbs.emplace_back(pos);
+                           else world.coins.emplace_back(pos);
+                       }
+                   },
+                   [&] { world.step({}); });
+    }
+}
+
+bool writeCsv(const std::string& path, const std::vector<Result>& results) {
+    std::ofstream out(path);
+    if (!out) return false;
+    out << "name,param,samples,median_ns,min_ns,p90_ns,ns_per_item\n";
+    out << std::fixed << std::setprecision(1);
+    for (const auto& r : results) {
+        out << r.name << ',' << r.param << ',' << r.samples << ',' << r.medianNs << ',' << r.minNs << ','
+            << r.p90Ns << ',' << r.nsPerItem << '\n';
+    }
+    return static_cast<bool>(out);
+}
+
+bool readCsv(const std::string& path, std::map<std::string, Result>& results) {
+    std::ifstream in(path);
+    if (!in) return false;
+    std::string line;
+    std::getline(in, line); // Header
+    while (std::getline(in, line)) {
+        std::istringstream fields(line);
+        std::string field;
+        Result r;
+        std::vector<std::string> parts;
+        while (std::getline(fields, field, ',')) parts.push_back(field);
+        if (parts.size() < 7) continue;
+        r.name = parts[0];
+        r.param = std::strtoull(parts[1].c_str(), nullptr, 10);
+        r.samples = std::strtoull(parts[2].c_str(), nullptr, 10);
+        r.medianNs = std::strtod(parts[3].c_str(), nullptr);
+        r.minNs = std::strtod(parts[4].c_str(), nullptr);
+        r.p90Ns = std::strtod(parts[5].c_str(), nullptr);
+        r.nsPerItem = std::strtod(parts[6].c_str(), nullptr);
+        results[r.name + "/" + std::to_string(r.param)] = r;
+    }
+    return true;
+}
+
+// Returns how many cases regressed past the threshold
+int compare(const std::vector<Result>& current, const std::map<std::string, Result>& baseline, double threshold) {
+    int regressions = 0;
+    std::cout << "\nAgainst baseline (threshold " << std::setprecision(0) << threshold * 100.0 << "%):" << std::endl;
+    for (const auto& r : current) {
+        std::string key = r.name + "/" + std::to_string(r.param);
+        auto it = baseline.find(key);
+        if (it == baseline.end()) {
+            std::cout << "  " << std::left << std::setw(32) << key << " new" << std::endl;
+            continue;
+        }
+        double change = it->second.medianNs > 0.0 ? r.medianNs / it->second.medianNs - 1.0 : 0.0;
+        bool regressed = change > threshold;
+        if (regressed) regressions++;
+        std::cout << "  " << std::left << std::setw(32) << key << std::right << std::showpos << std::setw(8)
+                  << std::setprecision(1) << change * 100.0 << std::noshowpos << "%"
+                  << (regressed ? "  REGRESSION" : "") << std::endl;
+    }
+    for (const auto& [key, r] : baseline) {
+        bool found = std::any_of(current.begin(), current.end(), [&](const Result& c) {
+            return c.name + "/" + std::to_string(c.param) == key;
+        });
+        if (!found) std::cout << "  " << std::left << std::setw(32) << key << " not run" << std::endl;
+    }
+    return regressions;
+}
+
+void printUsage() {
+    std::cerr << "Usage: lss_micro_bench [--filter TEXT] [--quick] [--out FILE] [--baseline FILE] [--threshold F]"
+              << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    std::string outPath;
+    std::string baselinePath;
+    double threshold = 0.10;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--filter" && i + 1 < argc) options.filter = argv[++i];
+        else if (arg == "--quick") options.quick = true;
+        else if (arg == "--out" && i + 1 < argc) outPath = argv[++i];
+        else if (arg == "--baseline" && i + 1 < argc) baselinePath = argv[++i];
+        else if (arg == "--threshold" && i + 1 < argc) threshold = std::strtod(argv[++i], nullptr);
+        else {
+            printUsage();
+            return 1;
+        }
+    }
+    if (options.quick) {
+        options.minSeconds = 0.1;
+        options.minSamples = 3;
+    }
+
+    Runner runner(options);
+    if (options.quick) {
+        benchRayBox(runner, {64, 1024});
+        benchParticles(runner, {1000, 10000});
+        benchBackground(runner, 30);
+        benchMusic(runner, 8);
+        benchEnemies(runner, {32, 256}, 30);
+        benchPickups(runner, {128, 1024});
+    } else {
+        benchRayBox(runner, {64, 1024, 16384});
+        benchParticles(runner, {1000, 10000, 100000, 1000000});
+        benchBackground(runner, 120);
+        benchMusic(runner, 32);
+        benchEnemies(runner, {32, 256, 2048, 16384}, 60);
+        benchPickups(runner, {128, 1024, 8192});
+    }
+
+    if (!outPath.empty()) {
+        if (writeCsv(outPath, runner.all())) std::cout << "Results written to " << outPath << std::endl;
+        else std::cerr << "Failed to write " << outPath << std::endl;
+    }
+
+    if (!baselinePath.empty()) {
+        std::map<std::string, Result> baseline;
+        if (!readCsv(baselinePath, baseline)) {
+            std::cerr << "Failed to read baseline " << baselinePath << std::endl;
+            return 1;
+        }
+        int regressions = compare(runner.all(), baseline, threshold);
+        if (regressions > 0) {
+            std::cout << regressions << " case(s) regressed" << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
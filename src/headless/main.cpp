@@ -0,0 +1,300 @@
+// Headless simulation runner: drives World without a window or audio device
+// and reports simulation throughput. Built separately from the game (see the
+// "Build Headless Sim" task) so it never links sfml-graphics/window/audio.
+//
+// Usage: lss_headless [--ticks N] [--seed S] [--input random|idle|<script>]
+//                     [--enemies N] [--record FILE] [--replay FILE] [--threads N]
+//
+// --enemies pins the swarm at N enemies (base and max) for stress runs.
+// --threads sets how many threads (caller included) run the per-tick jobs;
+// the final state hash printed at the end is the same for any count.
+// --seed drives both the random pilot and World::seed(), so a run repeats.
+// --record writes the ticks up to the first death as a binary recording
+// (see InputRecording.hpp). --replay runs a recording instead of --input,
+// taking the seed and swarm size from it, checks its state hashes and exits
+// with status 2 if the run diverged.
+//
+// Script format, one segment per line ('#' starts a comment):
+//   <ticks> [W] [A] [S] [D] [NITRO] [FIRE] [SHOCKWAVE] [REPAIR] [AIM dx dy]
+// Holds the listed buttons for <ticks> ticks. AIM is relative to the player;
+// without it the segment aims at the nearest enemy. The script loops.
+
+#include "World.hpp"
+#include "InputRecording.hpp"
+#include "JobSystem.hpp"
+#include "WorldEffects.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct ScriptSegment {
+    int ticks = 1;
+    PlayerInput input;
+    bool hasAim = false;
+    sf::Vector2f aimOffset;
+};
+
+sf::Vector2f nearestEnemy(const World& world) {
+    sf::Vector2f playerPos = world.player->position;
+    sf::Vector2f best = playerPos + sf::Vector2f(0.f, -100.f);
+    float bestDist = std::numeric_limits<float>::max();
+    for (std::size_t i = 0; i < world.enemies.size(); ++i) {
+        sf::Vector2f d = world.enemies.position(i) - playerPos;
+        float distSq = d.x * d.x + d.y * d.y;
+        if (distSq < bestDist) {
+            bestDist = distSq;
+            best = world.enemies.position(i);
+        }
+    }
+    return best;
+}
+
+bool loadScript(const std::string& path, std::vector<ScriptSegment>& segments) {
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "Failed to open input script " << path << std::endl;
+        return false;
+    }
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        line = line.substr(0, line.find('#'));
+        std::istringstream words(line);
+        ScriptSegment segment;
+        if (!(words >> segment.ticks)) continue; // Blank line
+        std::string word;
+        while (words >> word) {
+            if (word == "W") segment.input.up = true;
+            else if (word == "S") segment.input.down = true;
+            else if (word == "A") segment.input.left = true;
+            else if (word == "D") segment.input.right = true;
+            else if (word == "NITRO") segment.input.nitro = true;
+            else if (word == "FIRE") segment.input.fire = true;
+            else if (word == "SHOCKWAVE") segment.input.shockwave = true;
+            else if (word == "REPAIR") segment.input.repair = true;
+            else if (word == "AIM" && words >> segment.aimOffset.x >> segment.aimOffset.y) segment.hasAim = true;
+            else {
+                std::cerr << path << ":" << lineNumber << ": unknown token '" << word << "'" << std::endl;
+                return false;
+            }
+        }
+        segments.push_back(segment);
+    }
+    if (segments.empty()) {
+        std::cerr << "Input script " << path << " has no segments" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Wanders in random directions, fires at the nearest enemy and uses
+// shockwaves/repairs when it can, so every gameplay path gets exercised.
+class RandomPilot {
+public:
+    explicit RandomPilot(std::uint32_t seed) : rng(seed, RngStream::Pilot) {}
+
+    PlayerInput next(const World& world) {
+        const Player& player = *world.player;
+        if (ticksLeft-- <= 0) {
+            ticksLeft = rng.range(20, 120);
+            held = {};
+            held.up = rng.chance(0.5f);
+            held.down = !held.up && rng.chance(0.5f);
+            held.left = rng.chance(0.5f);
+            held.right = !held.left && rng.chance(0.5f);
+            held.nitro = rng.below(4) == 0;
+        }
+        PlayerInput input = held;
+        input.aim = nearestEnemy(world);
+        input.fire = player.canShoot();
+        input.shockwave = player.shockwaveCharges > 0 && rng.below(601) == 0;
+        input.repair = world.totalCoins >= World::repairCost && player.HP < player.maxHP / 2;
+        return input;
+    }
+
+private:
+    Rng rng;
+    PlayerInput held;
+    int ticksLeft = 0;
+};
+
+void printUsage() {
+    std::cerr << "Usage: lss_headless [--ticks N] [--seed S] [--input random|idle|<script>] [--enemies N]\n"
+                 "                    [--record FILE] [--replay FILE] [--threads N]" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::uint64_t tickBudget = 36000; // Ten minutes of game time
+    unsigned seed = std::random_device{}();
+    std::string inputMode = "random";
+    std::size_t swarmSize = 0;
+    std::string recordPath;
+    std::string replayPath;
+    bool ticksGiven = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--ticks" && i + 1 < argc) {
+            tickBudget = std::strtoull(argv[++i], nullptr, 10);
+            ticksGiven = true;
+        }
+        else if (arg == "--seed" && i + 1 < argc) seed = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        else if (arg == "--input" && i + 1 < argc) inputMode = argv[++i];
+        else if (arg == "--enemies" && i + 1 < argc) swarmSize = std::strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--record" && i + 1 < argc) recordPath = argv[++i];
+        else if (arg == "--replay" && i + 1 < argc) replayPath = argv[++i];
+        else if (arg == "--threads" && i + 1 < argc) {
+            int threads = std::max(1, std::atoi(argv[++i]));
+            JobSystem::instance().setWorkerCount(static_cast<unsigned>(threads - 1));
+        }
+        else {
+            printUsage();
+            return 1;
+        }
+    }
+
+    InputReplay replay;
+    if (!replayPath.empty()) {
+        if (!replay.open(replayPath)) return 1;
+        inputMode = "replay " + replayPath;
+        seed = replay.header().seed;
+        if (!ticksGiven) tickBudget = std::numeric_limits<std::uint64_t>::max();
+    }
+
+    std::vector<ScriptSegment> script;
+    if (replayPath.empty() && inputMode != "random" && inputMode != "idle") {
+        if (!loadScript(inputMode, script)) return 1;
+    }
+
+    // Same camera rectangle as a 1080p display
+    sf::Vector2f viewSize(1920.f, 1080.f);
+    sf::Vector2f spawn = viewSize / 2.f;
+    if (!replayPath.empty()) {
+        viewSize = replay.header().viewSize;
+        spawn = replay.header().spawn;
+    }
+    World world(viewSize);
+    if (!replayPath.empty()) {
+        world.baseEnemyCount = replay.header().baseEnemyCount;
+        world.maxEnemyCount = replay.header().maxEnemyCount;
+    } else if (swarmSize > 0) {
+        world.baseEnemyCount = swarmSize;
+        world.maxEnemyCount = swarmSize;
+    }
+    world.seed(seed);
+    world.reset(spawn);
+
+    InputRecorder recorder;
+    if (!recordPath.empty()) {
+        RecordingHeader header;
+        header.seed = seed;
+        header.viewSize = viewSize;
+        header.spawn = spawn;
+        header.baseEnemyCount = static_cast<std::uint32_t>(world.baseEnemyCount);
+        header.maxEnemyCount = static_cast<std::uint32_t>(world.maxEnemyCount);
+        if (!recorder.open(recordPath, header)) return 1;
+    }
+
+    RandomPilot pilot(seed);
+    std::size_t segmentIndex = 0;
+    int segmentTicks = 0;
+
+    std::uint64_t kills = 0;
+    std::uint64_t coinsPicked = 0;
+    std::uint64_t orbsPicked = 0;
+    // Events dispatch after every tick: counters here, particles and shake
+    // through WorldEffects like in the game
+    WorldEffects::subscribe(world);
+    world.events.subscribe<EnemyKilled>([&](std::span<const EnemyKilled> events) { kills += events.size(); });
+    world.events.subscribe<CoinCollected>([&](std::span<const CoinCollected> events) {
+        for (const CoinCollected& coin : events) coinsPicked += coin.value;
+    });
+    world.events.subscribe<OrbCollected>([&](std::span<const OrbCollected> events) { orbsPicked += events.size(); });
+    std::uint64_t deaths = 0;
+    std::size_t peakEnemies = 0;
+    std::size_t peakCoins = 0;
+    std::size_t peakParticles = 0;
+    float peakDifficulty = 1.f;
+
+    std::uint64_t ticksRun = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (; ticksRun < tickBudget; ++ticksRun) {
+        PlayerInput input;
+        if (!replayPath.empty()) {
+            if (!replay.next(input, world.player->position)) break;
+        } else if (inputMode == "random") {
+            input = pilot.next(world);
+        } else if (!script.empty()) {
+            const ScriptSegment& segment = script[segmentIndex];
+            input = segment.input;
+            input.aim = segment.hasAim ? world.player->position + segment.aimOffset : nearestEnemy(world);
+            if (++segmentTicks >= segment.ticks) {
+                segmentTicks = 0;
+                segmentIndex = (segmentIndex + 1) % script.size();
+            }
+        } else {
+            input.aim = nearestEnemy(world);
+        }
+
+        if (recorder.isOpen()) input = recorder.record(input, world.player->position);
+        world.step(input);
+        recorder.afterStep(world);
+        if (!replayPath.empty()) replay.afterStep(world);
+
+        world.events.dispatch();
+
+        peakEnemies = std::max(peakEnemies, world.enemies.size());
+        peakCoins = std::max(peakCoins, world.coins.size());
+        peakParticles = std::max(peakParticles, world.particleSystem.size());
+        peakDifficulty = std::max(peakDifficulty, world.difficulty);
+
+        if (world.gameOver) {
+            deaths++;
+            if (!replayPath.empty()) {
+                ticksRun++;
+                break; // Recordings end at the first death
+            }
+            world.reset(spawn);
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+
+    std::cout << "ticks:           " << ticksRun << "\n"
+              << "game time:       " << ticksRun * World::tickDt << " s\n"
+              << "wall time:       " << seconds << " s\n"
+              << "ticks/sec:       " << (seconds > 0.0 ? ticksRun / seconds : 0.0) << "\n"
+              << "speedup:         " << (seconds > 0.0 ? ticksRun * World::tickDt / seconds : 0.0) << "x\n"
+              << "input:           " << inputMode << " (seed " << seed << ")\n"
+              << "threads:         " << JobSystem::instance().workerCount() + 1 << "\n"
+              << "kills:           " << kills << "\n"
+              << "coins picked:    " << coinsPicked << "\n"
+              << "orbs picked:     " << orbsPicked << "\n"
+              << "deaths:          " << deaths << "\n"
+              << "peak enemies:    " << peakEnemies << "\n"
+              << "peak coins:      " << peakCoins << "\n"
+              << "peak particles:  " << peakParticles << "\n"
+              << "peak difficulty: " << peakDifficulty << "\n"
+              << "state hash:      " << std::hex << world.stateHash() << std::dec << std::endl;
+    if (recorder.ticks() > 0) {
+        std::cout << "recorded:        " << recorder.ticks() << " ticks to " << recordPath << std::endl;
+    }
+    if (!replayPath.empty()) {
+        std::cout << "state hashes:    " << replay.hashesChecked << " checked, "
+                  << (replay.diverged() ? "diverged by tick " + std::to_string(replay.divergedAt) : "all match")
+                  << std::endl;
+        if (replay.diverged()) return 2;
+    }
+    return 0;
+}
@@ -1,13 +1,23 @@
 
 #include "window.hpp"
 #include "player.hpp"
-#include "enemy.hpp"
+#include "Enemy.hpp"
 #include "Background.hpp"
 #include "effects.hpp"
 #include "TitleScreen.hpp"
 #include "MusicGenerator.hpp"
 #include "Coin.hpp"
 #include "HUD.hpp" // NEW
+#include "World.hpp"
+#include "WorldRenderer.hpp"
+#include "Profiler.hpp"
+#include "ProfilerOverlay.hpp"
+#include "ResourceCache.hpp"
+#include "AssetLoader.hpp"
+#include "InputRecording.hpp"
+#include "AudioMixer.hpp"
+#include "FloatingText.hpp"
+#include "WorldEffects.hpp"
 #include <vector>
 #include <random>
 #include <algorithm>
@@ -20,57 +30,13 @@
 #include <limits>
 #include <cstdint>
 #include <memory>
+#include <string>
+#include <cstdlib>
 
 using namespace std;
 
-inline bool containsPoint(const sf::FloatRect &rect, const sf::Vector2f &point)
-{
-    return point.x >= rect.position.x && point.x <= rect.position.x + rect.size.x &&
-           point.y >= rect.position.y && point.y <= rect.position.y + rect.size.y;
-}
-
-// Helper for ray-box intersection
-bool rayBoxIntersect(sf::Vector2f rayOrigin, sf::Vector2f rayDir, sf::FloatRect box, float& distance) {
-    float tmin = 0.0f;
-    float tmax = std::numeric_limits<float>::max();
-
-    sf::Vector2f min = {box.position.x, box.position.y};
-    sf::Vector2f max = {box.position.x + box.size.x, box.position.y + box.size.y};
-
-    // X axis
-    if (std::abs(rayDir.x) < 0.0001f) {
-        if (rayOrigin.x < min.x || rayOrigin.x > max.x) return false;
-    } else {
-        float ood = 1.0f / rayDir.x;
-        float t1 = (min.x - rayOrigin.x) * ood;
-        float t2 = (max.x - rayOrigin.x) * ood;
-        if (t1 > t2) std::swap(t1, t2);
-        tmin = std::max(tmin, t1);
-        tmax = std::min(tmax, t2);
-        if (tmin > tmax) return false;
-    }
-
-    // Y axis
-    if (std::abs(rayDir.y) < 0.0001f) {
-        if (rayOrigin.y < min.y || rayOrigin.y > max.y) return false;
-    } else {
-        float ood = 1.0f / rayDir.y;
-        float t1 = (min.y - rayOrigin.y) * ood;
-        float t2 = (max.y - rayOrigin.y) * ood;
-        if (t1 > t2) std::swap(t1, t2);
-        tmin = std::max(tmin, t1);
-        tmax = std::min(tmax, t2);
-        if (tmin > tmax) return false;
-    }
-
-    distance = tmin;
-    return true;
-}
-
-// Static RNG for orb drop probability
-static std::mt19937 rng(std::random_device{}());
-static std::uniform_real_distribution<float> orbDropChance(0.f, 1.f);
-constexpr float ORB_DROP_PROBABILITY = 0.25f;
+// Presentation-only choices (which blast sample to play)
+static Rng rng;
 
 enum class GameState {
     PRECREDIT,
@@ -79,64 +45,81 @@ enum class GameState {
     GAMEOVER
 };
 
+static PlayerInput sampleInput(const sf::Vector2f& mouseWorld)
+{
+    PlayerInput input;
+    input.up = sf::Keyboard::isKeyPressed(sf::Keyboard::Scan::W);
+    input.down = sf::Keyboard::isKeyPressed(sf::Keyboard::Scan::S);
+    input.left = sf::Keyboard::isKeyPressed(sf::Keyboard::Scan::A);
+    input.right = sf::Keyboard::isKeyPressed(sf::Keyboard::Scan::D);
+    input.nitro = sf::Keyboard::isKeyPressed(sf::Keyboard::Scan::Space);
+    input.fire = sf::Mouse::isButtonPressed(sf::Mouse::Button::Left);
+    input.shockwave = sf::Mouse::isButtonPressed(sf::Mouse::Button::Right);
+    input.repair = sf::Keyboard::isKeyPressed(sf::Keyboard::Scan::R);
+    input.aim = mouseWorld;
+    return input;
+}
+
+// Everything the game needs past the splash screen. Paths must match the
+// ones the systems ask the cache for, or they'll load a second time.
+static void queueGameAssets(AssetLoader& loader)
+{
+    using Kind = AssetLoader::Kind;
+    for (const char* path : {"resources/Player/Initial.png", "resources/Player/OnAcceleration.png",
+                             "resources/Player/OnBoost.png", "resources/Enemy_Initial.png",
+                             "resources/Enemy_BeforeExplosion.png", "resources/Laser.png",
+                             "resources/HitSplash/HS1.png", "resources/HitSplash/HS2.png",
+                             "resources/HitSplash/HS3.png", "resources/Title.png"}) {
+        loader.add(Kind::Texture, path);
+    }
+    for (int i = 1; i <= 8; ++i) {
+        loader.add(Kind::Texture, "resources/Coin/Coin" + std::to_string(i) + ".png");
+    }
+    // Packed into the background atlas, so they stay CPU-side
+    for (int i = 1; i <= 5; ++i) {
+        loader.add(Kind::Image, "resources/Stars/Star_" + std::to_string(i) + ".png");
+    }
+    for (int i = 1; i <= 9; ++i) {
+        loader.add(Kind::Image, "resources/Planets/Planet_" + std::to_string(i) + ".png");
+    }
+    for (const char* path : {"resources/Blast1.wav", "resources/Blast2.wav", "resources/LaserShoot.wav",
+                             "resources/1_Coins.ogg", "resources/bell.wav", "resources/UI_Button.wav"}) {
+        loader.add(Kind::SoundBuffer, path);
+    }
+}
+
 int main()
 {
-    
+
     Window Game("SHADE");
-    
+
     // Systems initialized via pointers for async loading
-    std::unique_ptr<Player> player;
+    std::unique_ptr<World> world;
+    std::unique_ptr<WorldRenderer> renderer;
     std::unique_ptr<Background> background;
-    std::unique_ptr<ScreenShake> screenShake;
-    std::unique_ptr<ParticleSystem> particleSystem;
     std::unique_ptr<TitleScreen> titleScreen;
 
+    // Every asset below comes from the shared cache, which logs failed loads
+    ResourceCache& resources = ResourceCache::instance();
+
     // Initialize PreCredit Scene
-    sf::Texture preCreditTexture;
-    if (!preCreditTexture.loadFromFile("resources/PreCredit.png")) {
-        std::cerr << "Failed to load PreCredit.png" << std::endl;
-    }
-    sf::Sprite preCreditSprite(preCreditTexture);
+    ResourceHandle<sf::Texture> preCreditTexture = resources.texture("resources/PreCredit.png");
+    sf::Sprite preCreditSprite(*preCreditTexture);
     sf::FloatRect pcBounds = preCreditSprite.getLocalBounds();
     preCreditSprite.setOrigin({pcBounds.size.x / 2.f, pcBounds.size.y / 2.f});
     preCreditSprite.setPosition({Game.center.x, Game.center.y});
 
-    // Load Blast Sounds
-    sf::SoundBuffer blastBuffer1;
-    if (!blastBuffer1.loadFromFile("resources/Blast1.wav")) {
-        std::cerr << "Failed to load Blast1.wav" << std::endl;
-    }
-    sf::Sound blastSound1(blastBuffer1);
-
-    sf::SoundBuffer blastBuffer2;
-    if (!blastBuffer2.loadFromFile("resources/Blast2.wav")) {
-        std::cerr << "Failed to load Blast2.wav" << std::endl;
-    }
-    sf::Sound blastSound2(blastBuffer2);
-
-    sf::SoundBuffer laserShootBuffer;
-    if (!laserShootBuffer.loadFromFile("resources/LaserShoot.wav")) {
-        std::cerr << "Failed to load LaserShoot.wav" << std::endl;
-    }
-    sf::Sound laserShootSound(laserShootBuffer);
-    laserShootSound.setVolume(50.f);
+    // Everything past the splash decodes in parallel while it plays
+    AssetLoader loader;
+    queueGameAssets(loader);
+    loader.start();
 
-    sf::SoundBuffer coinPickupBuffer;
-    if (!coinPickupBuffer.loadFromFile("resources/1_Coins.ogg")) {
-        std::cerr << "Failed to load 1_Coins.ogg" << std::endl;
-    }
-    sf::Sound coinPickupSound(coinPickupBuffer);
-    
-    sf::SoundBuffer powerupBuffer;
-    if (!powerupBuffer.loadFromFile("resources/bell.wav")) {
-         std::cerr << "Failed to load bell.wav" << std::endl;
-    }
-    sf::Sound powerupSound(powerupBuffer);
+    // Sound effects are registered once the loader has put their buffers in the cache
+    AudioMixer mixer;
+    AudioMixer::SoundId blastSound1 = 0, blastSound2 = 0, laserShootSound = 0, coinPickupSound = 0, powerupSound = 0;
 
-    sf::Font preCreditFont;
-    if (!preCreditFont.openFromFile("resources/Font/Jumps Winter.ttf")) {
-        std::cerr << "Failed to load Jumps Winter.ttf" << std::endl;
-    }
+    // Same face as Game.UiFont, so this is a cache hit
+    const sf::Font& preCreditFont = Game.UiFont;
     sf::Text preCreditText(preCreditFont, "OR ANY OTHER GAME ENGINE", 30);
     sf::FloatRect textBounds = preCreditText.getLocalBounds();
     preCreditText.setOrigin({textBounds.size.x / 2.f, textBounds.size.y / 2.f});
@@ -153,70 +136,137 @@ int main()
     float preCreditTimer = 0.f;
     GameState currentState = GameState::PRECREDIT;
     std::unique_ptr<HUD> hud;
-    int loadStage = 0;
-
-    std::vector<Laser> lasers;
-    lasers.reserve(32);
-
-    std::unique_ptr<HitSplash> hitSplashEffect;
-    // Initialize with dummy values, will be updated
-    hitSplashEffect = std::make_unique<HitSplash>(sf::Vector2f(0,0), 0.f);
-
-    std::vector<ShockwaveOrb> orbs;
-    orbs.reserve(16);
-    std::vector<ShockwaveRipple> shockwaveRipples;
-    shockwaveRipples.reserve(4);
-    
-    std::vector<FloatingText> floatingTexts;
-    
-    std::vector<Coin> coins;
-    coins.reserve(128);
-    int totalCoins = 0;
-    
-    std::vector<Enemy> enemies;
-    constexpr std::size_t baseEnemyCount = 4;
-    constexpr std::size_t maxEnemyCount = 32;
-    enemies.reserve(maxEnemyCount);
-    sf::Clock difficultyClock;
+
+    // Splash progress bar
+    sf::RectangleShape loadBarBack({400.f, 6.f});
+    loadBarBack.setOrigin({200.f, 3.f});
+    loadBarBack.setPosition({Game.center.x, preCreditText.getPosition().y + 50.f});
+    sf::RectangleShape loadBar({0.f, 6.f});
+    loadBar.setPosition(loadBarBack.getPosition() - loadBarBack.getOrigin());
+
+    FloatingTextPool floatingTexts(Game.UiFont);
+
     sf::Clock frameClock;
-    float difficulty = 1.f;
-    float difficultyTimeOffset = 0.f;
+    float accumulator = 0.f;
+
+    // F3 toggles the profiler overlay; the profile is dumped on exit if the
+    // overlay was opened or LSS_PROFILE is set
+    ProfilerOverlay profilerOverlay(Game.UiFont, sf::Vector2f(Game.width, Game.height));
+    bool dumpProfile = std::getenv("LSS_PROFILE") != nullptr;
+
+    // LSS_RECORD=<file> records each game from start to game over (a restart
+    // overwrites it). LSS_REPLAY=<file> plays a recording instead of reading
+    // the keyboard and mouse, with the recorded seeds, and checks its hashes.
+    // A replay skips the title and closes the game when it ends, so it can be
+    // scripted as a load test (tools/build_profiles.sh trains PGO this way).
+    const char* recordPath = std::getenv("LSS_RECORD");
+    const char* replayPath = std::getenv("LSS_REPLAY");
+    InputRecorder recorder;
+    InputReplay replay;
+    bool replaying = replayPath && replay.open(replayPath);
+    unsigned backgroundSeed = replaying ? replay.header().backgroundSeed : std::random_device{}();
+
+    auto reportReplay = [&]() {
+        std::cout << "Replay of " << replayPath << " finished after " << replay.ticks() << " ticks, "
+                  << replay.hashesChecked << " state hashes checked, "
+                  << (replay.diverged() ? "diverged by tick " + std::to_string(replay.divergedAt) : "all match")
+                  << std::endl;
+    };
+
+    // Sound and popups for the world's events. Each handler gets a frame's
+    // worth of one event type, so a wave of kills plays one blast, not ten.
+    std::vector<LaserHit> laserNumbers; // Scratch for the LaserHit handler
+    auto subscribePresentation = [&](GameEvents& events) {
+        events.subscribe<EnemyKilled>([&](std::span<const EnemyKilled> kills) {
+            // The mixer only keeps the loudest anyway: play the one closest to the ship
+            sf::Vector2f listener = world->player->position;
+            sf::Vector2f at = kills.front().position;
+            for (const EnemyKilled& kill : kills) {
+                sf::Vector2f d = kill.position - listener, best = at - listener;
+                if (d.x * d.x + d.y * d.y < best.x * best.x + best.y * best.y) at = kill.position;
+            }
+            mixer.play(rng.below(2) == 0 ? blastSound1 : blastSound2, at);
+        });
+        events.subscribe<LaserFired>([&](std::span<const LaserFired> shots) {
+            if (std::any_of(shots.begin(), shots.end(), [](const LaserFired& shot) { return shot.started; })) {
+                mixer.play(laserShootSound);
+            }
+        });
+        events.subscribe<LaserHit>([&](std::span<const LaserHit> hits) {
+            // One number per enemy hit this frame: its total, at the latest hit.
+            // Keyed on the spawn serial, so a slot that died and respawned
+            // within the frame still gets a number of its own.
+            laserNumbers.clear();
+            for (const LaserHit& hit : hits) {
+                auto same = std::find_if(laserNumbers.begin(), laserNumbers.end(),
+                                         [&](const LaserHit& number) { return number.enemy == hit.enemy; });
+                if (same == laserNumbers.end()) {
+                    laserNumbers.push_back(hit);
+                } else {
+                    same->damage += hit.damage;
+                    same->position = hit.position;
+                }
+            }
+            for (const LaserHit& number : laserNumbers) {
+                floatingTexts.spawnNumber(static_cast<int>(std::lround(number.damage)), number.position,
+                                          sf::Color(255, 220, 80), 0.6f, 0.8f);
+            }
+        });
+        events.subscribe<CoinCollected>([&](std::span<const CoinCollected>) { mixer.play(coinPickupSound); });
+        events.subscribe<OrbCollected>([&](std::span<const OrbCollected>) { mixer.play(powerupSound); });
+        events.subscribe<Repaired>([&](std::span<const Repaired> repairs) {
+            const Repaired& repair = repairs.back();
+            mixer.play(powerupSound);
+            floatingTexts.spawn("Repaired! -" + std::to_string(repair.cost), repair.position, sf::Color::Green);
+        });
+        events.subscribe<PlayerHit>([&](std::span<const PlayerHit> hits) {
+            if (!hits.back().fatal) return;
+            if (replaying) {
+                reportReplay();
+                Game.window.close();
+            }
+            mixer.play(blastSound2);
+            currentState = GameState::GAMEOVER;
+        });
+    };
 
     auto startNewGame = [&]() {
-        player = std::make_unique<Player>(Game.center.x, Game.center.y);
-        enemies.clear();
-        lasers.clear();
-        orbs.clear();
-        coins.clear();
-        shockwaveRipples.clear();
-        particleSystem->particles.clear();
-        floatingTexts.clear();
-        
-        totalCoins = 0;
-        difficultyClock.restart();
-        difficulty = 1.f;
-        difficultyTimeOffset = 0.f;
-        
-        // Initial enemies
-        for (std::size_t i = 0; i < baseEnemyCount; ++i)
-        {
-            enemies.emplace_back(Game);
-            enemies.back().applyDifficulty(difficulty);
+        // A fresh seed every game, unless a recording dictates it
+        if (replaying) replaying = replay.open(replayPath);
+        std::uint32_t seed = replaying ? replay.header().seed : std::random_device{}();
+        sf::Vector2f spawn = replaying ? replay.header().spawn : Game.center;
+        world->seed(seed);
+        rng.seed(seed, RngStream::Presentation);
+        floatingTexts.seed(seed);
+        world->reset(spawn);
+
+        if (recordPath) {
+            RecordingHeader header;
+            header.seed = seed;
+            header.backgroundSeed = backgroundSeed;
+            header.viewSize = world->viewSize;
+            header.spawn = spawn;
+            header.baseEnemyCount = static_cast<std::uint32_t>(world->baseEnemyCount);
+            header.maxEnemyCount = static_cast<std::uint32_t>(world->maxEnemyCount);
+            recorder.open(recordPath, header);
         }
-
+        floatingTexts.clear();
+        accumulator = 0.f;
         currentState = GameState::GAME;
     };
 
     while (Game.window.isOpen())
     {
-        bool isLaserHitting = false;
-        bool didShoot = false;
-        static bool wasShooting = false;
-        float dt = frameClock.restart().asSeconds();
-        dt = std::clamp(dt, 0.f, 0.05f);
+        float frameTime = frameClock.restart().asSeconds();
+        frameTime = std::min(frameTime, World::maxFrameTime);
+        // UI animations still run on real frame time
+        float dt = std::clamp(frameTime, 0.f, 0.05f);
+
+        Profiler::instance().endFrame();
 
+        // Input covers event polling and the mouse/keyboard snapshot
+        Profiler::Clock::time_point inputStart = Profiler::Clock::now();
         sf::Vector2i mousePixel = sf::Mouse::getPosition(Game.window);
-        sf::Vector2f mouseWorld = Game.window.mapPixelToCoords(mousePixel);
 
         // SFML 3.0-style polling returns std::optional<sf::Event>
         std::optional<sf::Event> event;
@@ -226,6 +276,11 @@ int main()
             {
                 Game.window.close();
             }
+            else if (const auto* keyEvent = event->getIf<sf::Event::KeyPressed>();
+                     keyEvent && keyEvent->code == sf::Keyboard::Key::F3) {
+                profilerOverlay.visible = !profilerOverlay.visible;
+                dumpProfile = true;
+            }
 
             else if (currentState == GameState::PRECREDIT) {
                 // Consume events but do nothing interactive
@@ -254,51 +309,43 @@ int main()
                 }
             }
         }
+        Profiler::instance().record(ProfileZone::Input, inputStart, Profiler::Clock::now());
 
         if (currentState == GameState::PRECREDIT) {
             preCreditTimer += dt;
-            
-            // Incremental Loading
-            switch (loadStage) {
-                case 0:
-                    player = std::make_unique<Player>(Game.center.x, Game.center.y);
-                    loadStage++;
-                    break;
-                case 1:
-                    background = std::make_unique<Background>("resources");
-                    loadStage++;
-                    break;
-                case 2:
-                    screenShake = std::make_unique<ScreenShake>();
-                    loadStage++;
-                    break;
-                case 3:
-                    particleSystem = std::make_unique<ParticleSystem>();
-                    loadStage++;
-                    break;
-                case 4:
-                    // ribbonTrail removed
-                    loadStage++;
-                    break;
-                case 5:
-                    titleScreen = std::make_unique<TitleScreen>();
-                    if (!titleScreen->init(Game.worldView.getSize().x, Game.worldView.getSize().y)) {
-                        std::cerr << "Failed to initialize Title Screen" << std::endl;
-                    }
-                    loadStage++;
-                    break;
-                case 6:
-                    for (std::size_t i = 0; i < baseEnemyCount; ++i)
-                    {
-                        enemies.emplace_back(Game);
-                        enemies.back().applyDifficulty(difficulty);
-                    }
-                    loadStage++;
-                    break;
-                case 7: 
-                    hud = std::make_unique<HUD>(Game.UiFont, sf::Vector2f(Game.width, Game.height));
-                    loadStage++;
-                    break;
+
+            // Decoding runs on the loader's threads; this only uploads textures
+            loader.update();
+
+            // Every system below finds its assets already in the cache
+            if (loader.done() && !world) {
+                world = std::make_unique<World>(replaying ? replay.header().viewSize : Game.worldView.getSize());
+                if (replaying) {
+                    world->baseEnemyCount = replay.header().baseEnemyCount;
+                    world->maxEnemyCount = replay.header().maxEnemyCount;
+                }
+                background = std::make_unique<Background>("resources", true, backgroundSeed);
+                titleScreen = std::make_unique<TitleScreen>();
+                if (!titleScreen->init(Game.worldView.getSize().x, Game.worldView.getSize().y)) {
+                    std::cerr << "Failed to initialize Title Screen" << std::endl;
+                }
+                renderer = std::make_unique<WorldRenderer>();
+                hud = std::make_unique<HUD>(Game.UiFont, sf::Vector2f(Game.width, Game.height));
+
+                using Category = AudioMixer::Category;
+                blastSound1 = mixer.addSound(resources.soundBuffer("resources/Blast1.wav"), Category::Explosion, 2.f);
+                blastSound2 = mixer.addSound(resources.soundBuffer("resources/Blast2.wav"), Category::Explosion, 2.f);
+                laserShootSound = mixer.addSound(resources.soundBuffer("resources/LaserShoot.wav"), Category::Weapon, 1.f, 50.f);
+                coinPickupSound = mixer.addSound(resources.soundBuffer("resources/1_Coins.ogg"), Category::Pickup, 0.5f);
+                powerupSound = mixer.addSound(resources.soundBuffer("resources/bell.wav"), Category::Powerup, 3.f);
+
+                // Particles and shake first, then sound and popups
+                WorldEffects::subscribe(*world);
+                subscribePresentation(world->events);
+
+                loader.logTimings(std::cout);
+                // The atlas has its own copy of the star and planet pixels
+                resources.purgeUnused();
             }
 
             float alpha = 255.f;
@@ -312,8 +359,15 @@ int main()
             c.a = static_cast<std::uint8_t>(alpha);
             preCreditSprite.setColor(c);
             preCreditText.setFillColor(c);
+            loadBarBack.setFillColor(sf::Color(255, 255, 255, c.a / 4));
+            loadBar.setFillColor(c);
+            loadBar.setSize({loadBarBack.getSize().x * loader.progress(), loadBarBack.getSize().y});
 
-            if (preCreditTimer >= 4.f && loadStage >= 8) { // Updated check
+            if (replaying && world) {
+                startNewGame();
+                continue;
+            }
+            if (preCreditTimer >= 4.f && world) {
                 currentState = GameState::TITLE;
             }
 
@@ -321,32 +375,30 @@ int main()
             Game.window.setView(Game.uiView);
             Game.window.draw(preCreditSprite);
             Game.window.draw(preCreditText);
+            Game.window.draw(loadBarBack);
+            Game.window.draw(loadBar);
             Game.window.display();
             continue;
         }
 
-        static sf::SoundBuffer bgmBuffer;
-        static std::unique_ptr<sf::Sound> bgm;
-        static bool bgmInitialized = false;
-        
-        if (!bgmInitialized && currentState != GameState::PRECREDIT) {
-             bgmBuffer = MusicGenerator::generateSpaceTrack();
-             bgm = std::make_unique<sf::Sound>(bgmBuffer);
-             bgm->setLooping(true);
-             bgm->setVolume(30.f); 
+        // Streamed, so starting it costs nothing up front
+        static std::unique_ptr<MusicGenerator> bgm;
+
+        if (!bgm && currentState != GameState::PRECREDIT) {
+             bgm = std::make_unique<MusicGenerator>();
+             bgm->setVolume(30.f);
              bgm->play();
-             bgmInitialized = true;
         }
 
         if (currentState == GameState::TITLE) {
             titleScreen->update(dt);
-            
+
             Game.window.clear(sf::Color::Black);
             // Draw background behind title for nice effect
             Game.window.setView(Game.worldView);
             background->update({0.f, 0.f}, Game.worldView.getSize()); // Static background for title
             background->draw(Game.window);
-            
+
             // Draw Title UI
             Game.window.setView(Game.uiView);
             titleScreen->draw(Game.window);
@@ -357,25 +409,25 @@ int main()
         if (currentState == GameState::GAMEOVER) {
             // Update background (slowly) for effect
             background->update({0.f, 0.f}, Game.worldView.getSize()); // Static or slowly moving could be nice, let's keep it static relative to last view
-            
+
             Game.window.clear(sf::Color::Black);
-            
+
             // Draw world in background (maybe darkened?)
             Game.window.setView(Game.worldView);
             background->draw(Game.window);
-            for (const auto &enemy : enemies) Game.window.draw(enemy.body);
+            renderer->drawEnemies(Game.window, *world, 1.f);
             // Don't draw player if they exploded, or maybe draw debris?
-            
+
             // UI Overlay
             Game.window.setView(Game.uiView);
-            
+
             // Darken background
             sf::RectangleShape overlay(sf::Vector2f(Game.uiView.getSize().x, Game.uiView.getSize().y));
             overlay.setFillColor(sf::Color(0, 0, 0, 150));
             overlay.setPosition({0.f, 0.f});
             // Center the overlay on the UI view
             overlay.setPosition(Game.uiView.getCenter() - Game.uiView.getSize()/2.f);
-            
+
             Game.window.draw(overlay);
             Game.window.draw(gameOverText);
             Game.window.display();
@@ -391,389 +443,122 @@ int main()
 
         // --- GAME LOOP ---
 
-        float elapsedSeconds = difficultyClock.getElapsedTime().asSeconds();
-        difficulty = 1.f + (elapsedSeconds - difficultyTimeOffset) / 60.f;
-        if (difficulty < 1.f) difficulty = 1.f; // Ensure difficulty doesn't drop below 1
-        difficulty = std::min(difficulty, 5.f);
-
-        std::size_t targetEnemyCount = std::min<std::size_t>(maxEnemyCount, static_cast<std::size_t>(baseEnemyCount * difficulty));
-        while (enemies.size() < targetEnemyCount)
+        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Scan::Escape))
         {
-            enemies.emplace_back(Game);
-            enemies.back().applyDifficulty(difficulty);
+            // Return to title screen instead of closing
+            currentState = GameState::TITLE;
+            continue;
         }
 
-        Game.worldView.setCenter(player->body.getPosition());
-        Game.window.setView(Game.worldView);
-        mouseWorld = Game.window.mapPixelToCoords(mousePixel);
+        Player& player = *world->player;
 
-        // Update Background
-        background->update(player->body.getPosition(), Game.worldView.getSize());
-        
-        // Update Effects
-        screenShake->update(dt);
-        particleSystem->update(dt);
-
-        bool wantsNitro = sf::Keyboard::isKeyPressed(sf::Keyboard::Scan::Space);
-        bool nitroActive = player->updateNitro(wantsNitro, dt);
-        player->maxSpeed = nitroActive ? player->nitroMaxSpeed : player->baseMaxSpeed;
-        float accelBoost = nitroActive ? player->nitroAccelMultiplier : 1.f;
-        float thrust = player->baseAcceleration * accelBoost * dt;
-        float frictionBase = nitroActive ? player->baseFriction * player->nitroFrictionFactor : player->baseFriction;
-        float friction = frictionBase * (dt * 60.f);
-        friction = std::clamp(friction, 0.01f, 0.3f);
-
-        bool isMoving = false;
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Scan::W))
-        {
-            isMoving = true;
-            if (player->velY > -player->maxSpeed)
-                player->accY = -(0.05f * player->velY) - thrust;
-        }
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Scan::S))
-        {
-            isMoving = true;
-            if (player->velY < player->maxSpeed)
-                player->accY = -(0.05f * player->velY) + thrust;
-        }
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Scan::A))
-        {
-            isMoving = true;
-            if (player->velX > -player->maxSpeed)
-                player->accX = -(0.05f * player->velX) - thrust;
-        }
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Scan::D))
-        {
-            isMoving = true;
-            if (player->velX < player->maxSpeed)
-                player->accX = -(0.05f * player->velX) + thrust;
-        }
-        
-        // Particle Emission for Movement
-        float speedSq = player->velX * player->velX + player->velY * player->velY;
-        if (speedSq > 100.f) { // Only emit if moving
-            sf::Vector2f velocity(player->velX, player->velY);
-            sf::Vector2f direction = -velocity; // Opposite to movement
-            float len = std::sqrt(direction.x*direction.x + direction.y*direction.y);
-            if (len > 0.001f) direction /= len;
-            
-            // Randomize position slightly for trail thickness
-            sf::Vector2f pos = player->body.getPosition();
-            pos.x += std::uniform_real_distribution<float>(-10.f, 10.f)(rng);
-            pos.y += std::uniform_real_distribution<float>(-10.f, 10.f)(rng);
-
-            // Cone emission
-            particleSystem->emitCone(pos, direction, 0.5f, 1, sf::Color::White, 100.f); 
-        }
-        
-        player->updateTexture(isMoving);
-        player->updateLaserEnergy(dt);
+        // Aim is resolved against the camera as it was last drawn
+        inputStart = Profiler::Clock::now();
+        sf::Vector2f mouseWorld = Game.window.mapPixelToCoords(mousePixel, Game.worldView);
+        PlayerInput input = sampleInput(mouseWorld);
+        Profiler::instance().record(ProfileZone::Input, inputStart, Profiler::Clock::now());
 
-        if (sf::Mouse::isButtonPressed(sf::Mouse::Button::Left))
+        // Fixed-step simulation: run as many ticks as real time has accumulated
+        accumulator += frameTime;
         {
-            if (player->canShoot()) {
-                sf::Vector2f playerPos = player->body.getPosition();
-                sf::Vector2f dir = mouseWorld - playerPos;
-                float len = std::sqrt(dir.x*dir.x + dir.y*dir.y);
-                if (len > 0.0001f) dir /= len;
-                
-                float angleDeg = player->body.getRotation().asDegrees() - 90.f;
-                
-                // Raycast
-                float minDistance = 2000.f; // Max laser length
-                Enemy* hitEnemy = nullptr;
-                
-                // Check enemies
-                for(auto& enemy : enemies) {
-                    float dist = 0.f;
-                    if(rayBoxIntersect(playerPos, dir, enemy.body.getGlobalBounds(), dist)) {
-                        if(dist < minDistance) {
-                            minDistance = dist;
-                            hitEnemy = &enemy;
-                        }
+            PROFILE_SCOPE(Simulation);
+            bool replayEnded = false;
+            while (accumulator >= World::tickDt && !world->gameOver)
+            {
+                PlayerInput tickInput = input;
+                if (replaying) {
+                    if (!replay.next(tickInput, player.position)) {
+                        replayEnded = true;
+                        break;
                     }
+                } else if (recorder.isOpen()) {
+                    tickInput = recorder.record(input, player.position);
                 }
-                
-                // Check screen bounds (simple approximation)
-                // We just let it go to max distance if no enemy hit, or clamp to screen edge if we wanted to be precise.
-                // For now, let's just use minDistance.
-                
-                lasers.emplace_back(playerPos, angleDeg, minDistance);
-                
-                if(hitEnemy) {
-                    hitEnemy->takeDamage(2); // Damage based on visible time (reduced for continuous fire)
-                    hitEnemy->applyKnockback(dir, 0.5f); // Reduced knockback per frame
-                    
-                    // Update Hit Splash
-                    hitSplashEffect->setPosition(playerPos + dir * (minDistance - 10.f));
-                    hitSplashEffect->setRotation(angleDeg);
-                    hitSplashEffect->update(dt);
-                    isLaserHitting = true;
-                }
-
-                
-                player->consumeLaserEnergy();
-                screenShake->addTrauma(0.01f); // Reduced trauma per frame
-                didShoot = true;
+                world->step(tickInput);
+                recorder.afterStep(*world);
+                if (replaying) replay.afterStep(*world);
+                accumulator -= World::tickDt;
+            }
+            if (replayEnded) {
+                reportReplay();
+                Game.window.close();
+                continue;
             }
         }
+        float alpha = accumulator / World::tickDt;
 
-        if (didShoot && !wasShooting) {
-             laserShootSound.play();
-        }
-        wasShooting = didShoot;
+        // Tempo and density follow the swarm without re-rendering anything
+        if (bgm) bgm->setDifficulty(world->difficulty);
 
+        // React to what happened during this frame's ticks
+        mixer.setListener(player.position);
+        world->events.dispatch();
+        mixer.update(dt);
 
-        // Handle shockwave activation (right mouse button)
-        static bool rightMousePressed = false;
-        bool rightMouseCurrentlyPressed = sf::Mouse::isButtonPressed(sf::Mouse::Button::Right);
-        if (rightMouseCurrentlyPressed && !rightMousePressed)
-        {
-            // Right mouse button just pressed
-            if (player->activateShockwave()) {
-                shockwaveRipples.emplace_back(player->body.getPosition());
-                
-                // Multiply the difficulty by 3/4
-                // Current difficulty: D = 1 + (T - Offset) / 60
-                // Target difficulty: D' = D * 0.75
-                // D' = 1 + (T - NewOffset) / 60
-                // D*0.75 - 1 = (T - NewOffset) / 60
-                // 60 * (D*0.75 - 1) = T - NewOffset
-                // NewOffset = T - 60 * (D*0.75 - 1)
-                
-                float currentT = difficultyClock.getElapsedTime().asSeconds();
-                float targetD = difficulty * 0.75f;
-                if (targetD < 1.f) targetD = 1.f;
-                
-                float newOffset = currentT - (targetD - 1.f) * 60.f;
-                difficultyTimeOffset = newOffset;
-            }
-        }
-        rightMousePressed = rightMouseCurrentlyPressed;
+        renderer->update(*world, dt);
+        floatingTexts.update(dt);
 
-        // Update shockwave timer
-        player->updateShockwave(dt);
-        
-        // Update Ripples
-        shockwaveRipples.erase(std::remove_if(shockwaveRipples.begin(), shockwaveRipples.end(),
-            [&](ShockwaveRipple& r) { return !r.update(dt); }),
-            shockwaveRipples.end());
+        // Camera follows the interpolated player position
+        sf::Vector2f playerDrawPos = interpolate(player.prevPosition, player.position, alpha);
+        Game.worldView.setCenter(playerDrawPos);
 
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Scan::Escape))
+        // Update Background
         {
-            // Return to title screen instead of closing
-            currentState = GameState::TITLE;
-            continue;
+            PROFILE_SCOPE(BackgroundUpdate);
+            background->update(playerDrawPos, Game.worldView.getSize(), {player.velX, player.velY});
         }
 
-        // Repair Mechanic
-        static bool rKeyPressed = false;
-        bool rKeyCurrentlyPressed = sf::Keyboard::isKeyPressed(sf::Keyboard::Scan::R);
-        if (rKeyCurrentlyPressed && !rKeyPressed) {
-            if (totalCoins >= 500 && player->HP < player->maxHP) {
-                totalCoins -= 500;
-                player->HP = player->maxHP;
-                powerupSound.play();
-                floatingTexts.emplace_back(Game.UiFont, "Repaired! -500", player->body.getPosition(), sf::Color::Green);
-            }
-        }
-        rKeyPressed = rKeyCurrentlyPressed;
-
-        player->deaccelerate(player->velY, player->accY, false, friction);
-        player->deaccelerate(player->velX, player->accX, true, friction);
-        player->RotateTowards(mouseWorld);
-
-        Game.worldView.setCenter(player->body.getPosition());
-        Game.window.setView(Game.worldView);
-
-        player->diagonalhandle();
         // Update HUD
-        if(hud) hud->update(*player, totalCoins, dt);
-
-        // Update lasers
-        sf::Vector2f currentPlayerPos = player->body.getPosition();
-        float currentPlayerRotation = player->body.getRotation().asDegrees();
-        
-        lasers.erase(std::remove_if(lasers.begin(), lasers.end(),
-                                     [&](Laser &l)
-                                     {
-                                         l.body.setPosition(currentPlayerPos);
-                                         l.body.setRotation(sf::degrees(currentPlayerRotation - 90.f));
-                                         return !l.update(dt);
-                                     }),
-                      lasers.end());
-
-        // Update Hit Splashes - Removed as we use single instance now
-        // hitSplashes.erase(...)
-
-        // Remove bullets that went off-screen (with margin)
-        sf::FloatRect viewBounds = Game.getViewBounds(64.f);
-        sf::FloatRect tightViewBounds = Game.getViewBounds();
-        float leftBound = viewBounds.position.x;
-        float rightBound = viewBounds.position.x + viewBounds.size.x;
-        float topBound = viewBounds.position.y;
-        float bottomBound = viewBounds.position.y + viewBounds.size.y;
-
-        // Update orbs, check for collection, and remove off-screen orbs in one optimized pass
-        sf::Vector2f playerPos = player->body.getPosition();
-        orbs.erase(std::remove_if(orbs.begin(), orbs.end(),
-                                  [&](ShockwaveOrb &orb)
-                                  {
-                                      orb.update(playerPos);
-                                      if (orb.isCollected(playerPos))
-                                      {
-                                          player->addShockwaveCharge();
-                                          powerupSound.play();
-                                          return true; // Remove collected orb
-                                      }
-                                      sf::Vector2f p = orb.body.getPosition();
-                                      return p.x < leftBound || p.y < topBound || p.x > rightBound || p.y > bottomBound;
-                                  }),
-                   orbs.end());
-
-        // Update Coins
-        coins.erase(std::remove_if(coins.begin(), coins.end(),
-                                   [&](Coin &c)
-                                   {
-                                       c.update(playerPos, dt);
-                                       if (c.isCollected(playerPos))
-                                       {
-                                           totalCoins++;
-                                           if (coinPickupSound.getStatus() != sf::Sound::Status::Playing) {
-                                               coinPickupSound.play();
-                                           }
-                                           return true;
-                                       }
-                                       // Despawn if too far
-                                       if (c.isTooFar(playerPos)) {
-                                            return true;
-                                       }
-                                       return false;
-                                   }),
-                                   coins.end());
-         
-        float playerSpeedSquared = player->velX * player->velX + player->velY * player->velY;
-        for (auto &enemy : enemies)
         {
-            enemy.update(dt);
-            if (enemy.HP <= 0)
-            {
-                // Enemy Death Effects
-                if (std::uniform_int_distribution<int>(0, 1)(rng) == 0) {
-                    blastSound1.play();
-                } else {
-                    blastSound2.play();
-                }
-                screenShake->addTrauma(0.4f);
-                particleSystem->emit(enemy.body.getPosition(), 20, sf::Color::Red, 150.f);
-                
-                // Spawn shockwave orb when enemy is killed (25% probability)
-                if (orbDropChance(rng) < ORB_DROP_PROBABILITY)
-                {
-                    orbs.emplace_back(enemy.body.getPosition());
-                }
-                
-                // Spawn Coins
-                int coinCount = std::uniform_int_distribution<int>(1, 3)(rng);
-                for(int i=0; i<coinCount; ++i) {
-                     sf::Vector2f offset = {static_cast<float>(std::uniform_int_distribution<int>(-20, 20)(rng)), 
-                                            static_cast<float>(std::uniform_int_distribution<int>(-20, 20)(rng))};
-                     coins.emplace_back(enemy.body.getPosition() + offset);
-                }
-                
-                enemy.applyDifficulty(difficulty);
-                enemy.respawn(Game.worldView, 50.f);
-                continue;
-            }
-
-            bool enemyOffscreen = !containsPoint(tightViewBounds, enemy.body.getPosition());
-            if (enemyOffscreen && playerSpeedSquared > 16.f)
-            {
-                sf::Vector2f toEnemy = enemy.body.getPosition() - player->body.getPosition();
-                float dot = player->velX * toEnemy.x + player->velY * toEnemy.y;
-                if (dot < 0.f)
-                {
-                    enemy.applyDifficulty(difficulty);
-                    enemy.respawn(Game.worldView, 50.f);
-                    continue;
-                }
-            }
-
-            // Check if enemy is close enough to explode
-            sf::Vector2f playerPos = player->body.getPosition();
-
-            // Update visual state (warning colors)
-            enemy.updateVisualState(playerPos);
-
-            if (enemy.shouldExplode(playerPos))
-            {
-                // Enemy explodes, dealing damage to player
-                player->takeDamage(enemy.explosionDamage);
-                
-                // Player Hit Effects
-                screenShake->addTrauma(0.8f);
-                particleSystem->emit(playerPos, 30, sf::Color::Red, 200.f);
-                
-                // Respawn the enemy after explosion
-                enemy.applyDifficulty(difficulty);
-                enemy.respawn(Game.worldView, 50.f);
-                
-                if (player->HP <= 0) {
-                     currentState = GameState::GAMEOVER;
-                     blastSound2.play();
-                     break;
-                }
-                continue;
-            }
-
-            // Apply shockwave repulsion if active
-            if (player->shockwaveActive)
-            {
-                enemy.applyShockwave(playerPos, player->shockwaveForce, dt);
-            }
-            else
-            {
-                enemy.moveTowards(playerPos);
-            }
+            PROFILE_SCOPE(HudUpdate);
+            if(hud) hud->update(player, world->totalCoins, dt);
         }
-        
+        profilerOverlay.update(dt);
+
         Game.window.clear(sf::Color::Black);
-        
+
         // Apply Screen Shake
-        screenShake->apply(Game.worldView, elapsedSeconds);
+        world->screenShake.apply(Game.worldView, world->elapsed + alpha * World::tickDt);
         Game.window.setView(Game.worldView);
-        
+
         // Draw Background
-        background->draw(Game.window, {player->velX, player->velY});
-        
-        // Draw Ripples (behind entities but above background)
-        for (auto& ripple : shockwaveRipples) {
-            ripple.draw(Game.window);
+        {
+            PROFILE_SCOPE(DrawBackground);
+            background->draw(Game.window, {player.velX, player.velY});
         }
-        
-        // Draw Particles (behind entities)
-        particleSystem->draw(Game.window);
-
-        for (const auto &l : lasers)
-            Game.window.draw(l.body);
-        for (const auto &orb : orbs)
-            Game.window.draw(orb.body);
-            
-        for (auto &coin : coins)
-            coin.draw(Game.window);
-
-        Game.window.draw(player->body);
-        for (auto &enemy : enemies)
-            enemy.trail.draw(Game.window, sf::Color(255, 50, 50));
-        for (const auto &enemy : enemies)
-            Game.window.draw(enemy.body);
-        if (isLaserHitting)
-            Game.window.draw(hitSplashEffect->sprite);
+
+        renderer->draw(Game.window, *world, alpha);
+        floatingTexts.draw(Game.window);
         Game.window.setView(Game.uiView);
         // Draw HUD
-        if(hud) hud->draw(Game.window);
+        {
+            PROFILE_SCOPE(DrawHud);
+            if(hud) hud->draw(Game.window);
+        }
+        profilerOverlay.draw(Game.window);
 
-        Game.window.display();
+        {
+            // Includes the vsync wait
+            PROFILE_SCOPE(Present);
+            Game.window.display();
+        }
     }
-}
 
+    // The background worker records scopes too; stop it so the trace is
+    // read with no other thread still writing the event ring
+    background.reset();
+
+    if (dumpProfile) {
+        Profiler& profiler = Profiler::instance();
+        if (profiler.writeCsv("profile.csv") && profiler.writeChromeTrace("profile_trace.json")) {
+            std::cout << "Profile written to profile.csv and profile_trace.json" << std::endl;
+        } else {
+            std::cerr << "Failed to write profile" << std::endl;
+        }
+        resources.report(std::cout);
+    }
+
+    // Release the cache's textures and fonts while Game's context still
+    // exists; the function-local singleton would otherwise outlive it
+    resources.clear();
+}
@@ -7,13 +7,11 @@ Window::Window(const std::string& title)
       center(width / 2.f, height / 2.f),
       window(display, title, sf::State::Fullscreen),
       worldView(window.getDefaultView()),
-      uiView(worldView)
+      uiView(worldView),
+      UiFontHandle(ResourceCache::instance().font("resources/Font/Jumps Winter.ttf")),
+      UiFont(*UiFontHandle)
 {
     window.setVerticalSyncEnabled(true);
     window.setFramerateLimit(60);
     window.setView(worldView);
-
-    if (!UiFont.openFromFile("resources/Font/Jumps Winter.ttf")) {
-        // Handle error if needed, but for now we just log
-    }
 }
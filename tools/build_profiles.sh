@@ -0,0 +1,152 @@
+#!/usr/bin/env bash
+# Builds the Release, Release+LTO and PGO configurations, trains the PGO
+# build on the scripted sessions in tools/sessions and writes a frame-time
+# comparison of the three to build/profiles/report.md.
+#
+# Usage: tools/build_profiles.sh [--skip-build] [--jobs N]
+#
+# Training, per session script:
+#   1. the instrumented lss_headless plays the script and records it
+#      (tools/sessions/*.txt; each file's "# args:" line holds its flags),
+#   2. the instrumented game replays the recording (LSS_REPLAY), so the
+#      renderer's draw-list building, the background streaming and the HUD
+#      are trained on the same sessions as the simulation.
+# The report replays the same recordings in every build with LSS_PROFILE set
+# and compares CPU frame time (frame time minus Present, which holds the
+# vsync/frame-limit wait), plus headless replay throughput.
+#
+# Without a display the game runs under xvfb-run. Needs SFML 3 where CMake
+# can find it, and llvm-profdata when building with Clang.
+
+set -euo pipefail
+
+root="$(cd "$(dirname "$0")/.." && pwd)"
+cd "$root"
+
+jobs="$(nproc)"
+skipBuild=0
+while [[ $# -gt 0 ]]; do
+    case "$1" in
+        --skip-build) skipBuild=1 ;;
+        --jobs) jobs="$2"; shift ;;
+        *) echo "Usage: $0 [--skip-build] [--jobs N]" >&2; exit 1 ;;
+    esac
+    shift
+done
+
+out="build/profiles"
+recordings="$out/recordings"
+mkdir -p "$recordings"
+
+runGame() {
+    if [[ -n "${DISPLAY:-}" ]]; then
+        "$@"
+    else
+        xvfb-run -a -s "-screen 0 1920x1080x24" "$@"
+    fi
+}
+
+configure() {
+    local dir="$1"; shift
+    cmake -S . -B "$dir" -DCMAKE_BUILD_TYPE=Release "$@" > /dev/null
+    cmake --build "$dir" -j"$jobs"
+}
+
+compilerId() {
+    sed -n 's/^CMAKE_CXX_COMPILER_ID:[A-Z]*=//p' "$1/CMakeCache.txt"
+}
+
+# Plays every session script in the given build and records it
+recordSessions() {
+    local dir="$1"
+    for script in tools/sessions/*.txt; do
+        local name args
+        name="$(basename "$script" .txt)"
+        args="$(sed -n 's/^# args: //p' "$script")"
+        # shellcheck disable=SC2086
+        "$dir/lss_headless" --input "$script" $args --record "$recordings/$name.lssr" > /dev/null
+    done
+}
+
+if [[ $skipBuild -eq 0 ]]; then
+    configure build/release
+    configure build/lto -DLSS_LTO=ON
+
+    # PGO: instrument, train, then rebuild the same tree with the profile
+    rm -rf build/pgo/pgo-data
+    configure build/pgo -DLSS_LTO=ON -DLSS_PGO=GENERATE
+    echo "Training..."
+    recordSessions build/pgo
+    for recording in "$recordings"/*.lssr; do
+        "build/pgo/lss_headless" --replay "$recording" > /dev/null
+        LSS_REPLAY="$recording" runGame build/pgo/lss > /dev/null
+    done
+    if [[ "$(compilerId build/pgo)" == *Clang* ]]; then
+        llvm-profdata merge -o build/pgo/pgo-data/lss.profdata build/pgo/pgo-data/*.profraw
+    fi
+    cmake -S . -B build/pgo -DLSS_PGO=USE > /dev/null
+    cmake --build build/pgo -j"$jobs" --clean-first
+else
+    recordSessions build/release
+fi
+
+# Mean, percentiles, max and count of numbers read one per line
+summarize() {
+    sort -n | awk '
+        function pct(p,    i) { i = int(NR * p) + 1; return v[i > NR ? NR : i] }
+        { v[NR] = $1; sum += $1 }
+        END {
+            if (NR == 0) { print "| - | - | - | - | - | 0 |"; exit }
+            printf "| %.3f | %.3f | %.3f | %.3f | %.3f | %d |\n", sum / NR, pct(0.5), pct(0.9), pct(0.99), v[NR], NR
+        }'
+}
+
+# CPU ms of the gameplay frames in a profile.csv (frames that drew entities)
+cpuFrames() {
+    awk -F, '
+        FNR == 1 { for (i = 1; i <= NF; i++) col[$i] = i; next }
+        $col["DrawEntities_ms"] > 0 { print $col["frame_ms"] - $col["Present_ms"] }' "$@"
+}
+
+report="$out/report.md"
+{
+    echo "# Frame-time comparison"
+    echo
+    echo "Sessions: $(ls tools/sessions/*.txt | xargs -n1 basename | tr '\n' ' ')"
+    echo "Compiler: $(compilerId build/release), $(date -u +%Y-%m-%d)"
+    echo
+    echo "## CPU frame time (ms, frame minus Present)"
+    echo
+    echo "| Build | Mean | p50 | p90 | p99 | Max | Frames |"
+    echo "|---|---|---|---|---|---|---|"
+} > "$report"
+
+throughput=()
+for config in release lto pgo; do
+    mkdir -p "$out/$config"
+    ticksPerSec=0
+    for recording in "$recordings"/*.lssr; do
+        name="$(basename "$recording" .lssr)"
+        rm -f profile.csv profile_trace.json
+        LSS_PROFILE=1 LSS_REPLAY="$recording" runGame "build/$config/lss" > /dev/null
+        mv profile.csv "$out/$config/$name.csv"
+        rm -f profile_trace.json
+        rate="$("build/$config/lss_headless" --replay "$recording" | sed -n 's/^ticks\/sec: *//p')"
+        ticksPerSec="$(awk -v a="$ticksPerSec" -v b="$rate" 'BEGIN { print a + b }')"
+    done
+    echo "| $config $(cpuFrames "$out/$config"/*.csv | summarize)" >> "$report"
+    throughput+=("| $config | $(awk -v t="$ticksPerSec" -v n="$(ls "$recordings"/*.lssr | wc -l)" 'BEGIN { printf "%.0f", t / n }') |")
+done
+
+{
+    echo
+    echo "## Headless replay throughput (ticks/s, mean over sessions)"
+    echo
+    echo "| Build | Ticks/s |"
+    echo "|---|---|"
+    printf '%s\n' "${throughput[@]}"
+    echo
+    echo "Per-frame zone timings are in $out/<build>/<session>.csv."
+} >> "$report"
+
+cat "$report"